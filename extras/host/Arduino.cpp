@@ -0,0 +1,339 @@
+/*******************************************************************************
+* RoboCore Arduino Host Shim (v1.1)
+*
+* Minimal Arduino core to compile the library on a computer (Linux), so that
+* it can be tested with the emulator of the module.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+#include "Arduino.h"
+
+// --------------------------------------------------
+// Dependencies
+
+#include <chrono>
+#include <map>
+#include <thread>
+#include <utility>
+
+// --------------------------------------------------
+// Variables
+
+static uint8_t pin_values[HOST_PIN_COUNT];
+static HostPinListener pin_listener = nullptr;
+static void *pin_listener_context = nullptr;
+
+// virtual clock
+static bool clock_virtual = false;
+static bool clock_idle = false; // true if there was no activity since the last reading
+static bool clock_firing = false; // true while calling the timers
+static uint64_t clock_time = 0; // [us]
+static std::multimap<uint32_t, std::pair<HostTimerCallback, void *>> clock_timers; // (by time, in the order of creation)
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Get the time since the start of the program
+//  @returns the time in microseconds [uint64_t]
+static uint64_t host_time(void){
+  if(clock_virtual){
+    return clock_time;
+  }
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// --------------------------------------------------
+
+// Advance the virtual clock, calling the timers on their exact time
+//  @param (duration) : the time to advance in microseconds [uint64_t]
+static void host_clock_forward(uint64_t duration){
+  uint64_t target = clock_time + duration;
+  if(clock_firing){
+    clock_time = target; // (the outer call handles the timers)
+    return;
+  }
+
+  clock_firing = true; // set
+  while(!clock_timers.empty() && ((clock_timers.begin()->first * 1000ULL) <= target)){
+    std::multimap<uint32_t, std::pair<HostTimerCallback, void *>>::iterator it = clock_timers.begin();
+    std::pair<HostTimerCallback, void *> timer = it->second;
+    if(clock_time < (it->first * 1000ULL)){
+      clock_time = it->first * 1000ULL;
+    }
+    clock_timers.erase(it);
+    timer.first(timer.second);
+    if(target < clock_time){
+      target = clock_time; // (the timer advanced the clock)
+    }
+  }
+  clock_time = target;
+  clock_firing = false; // reset
+}
+
+// --------------------------------------------------
+
+// NOTE: with the virtual clock, reading the time counts as a poll (see <host_clock_poll()>)
+uint32_t millis(void){
+  host_clock_poll();
+  return host_time() / 1000;
+}
+
+uint32_t micros(void){
+  if(clock_virtual){
+    if(clock_idle){
+      host_clock_forward(1);
+    }
+    clock_idle = true; // set
+  }
+  return host_time();
+}
+
+void delay(uint32_t duration){
+  if(clock_virtual){
+    host_clock_forward(duration * 1000ULL);
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+}
+
+void delayMicroseconds(uint32_t duration){
+  if(clock_virtual){
+    host_clock_forward(duration);
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::microseconds(duration));
+}
+
+void yield(void){
+  // nothing to do here
+}
+
+// --------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode){
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value){
+  value = (value == LOW) ? LOW : HIGH;
+  if(pin_values[pin] == value){
+    return; // no change
+  }
+  pin_values[pin] = value;
+  if(pin_listener){
+    pin_listener(pin, value, pin_listener_context);
+  }
+}
+
+int digitalRead(uint8_t pin){
+  return pin_values[pin];
+}
+
+// --------------------------------------------------
+
+long random(long max){
+  if(max <= 0){
+    return 0;
+  }
+  return rand() % max;
+}
+
+long random(long min, long max){
+  if(min >= max){
+    return min;
+  }
+  return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed){
+  if(seed != 0){
+    srand(seed);
+  }
+}
+
+// --------------------------------------------------
+
+char* ultoa(unsigned long value, char *str, int base){
+  static const char DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  if((base < 2) || (base > 36)){
+    str[0] = '\0';
+    return str;
+  }
+
+  // convert in reverse order
+  uint8_t length = 0;
+  do {
+    str[length++] = DIGITS[value % base];
+    value /= base;
+  } while(value > 0);
+  str[length] = '\0';
+
+  for(uint8_t i=0 ; i < (length / 2) ; i++){
+    char temp = str[i];
+    str[i] = str[length - 1 - i];
+    str[length - 1 - i] = temp;
+  }
+  return str;
+}
+
+char* ltoa(long value, char *str, int base){
+  if((value < 0) && (base == 10)){
+    str[0] = '-';
+    ultoa(-static_cast<unsigned long>(value), &str[1], base);
+    return str;
+  }
+  return ultoa(static_cast<unsigned long>(value), str, base);
+}
+
+char* itoa(int value, char *str, int base){
+  if(base != 10){
+    return ultoa(static_cast<unsigned int>(value), str, base); // (as two's complement)
+  }
+  return ltoa(value, str, base);
+}
+
+char* utoa(unsigned int value, char *str, int base){
+  return ultoa(value, str, base);
+}
+
+// --------------------------------------------------
+
+// Set the function to call when an output pin changes
+//  @param (listener) : the function to call (nullptr to remove) [HostPinListener]
+//         (context)  : the context for the listener [void *] (default: nullptr)
+//  NOTE: used by the emulator to detect the hardware reset
+void host_set_pin_listener(HostPinListener listener, void *context){
+  pin_listener = listener;
+  pin_listener_context = context;
+}
+
+// --------------------------------------------------
+
+// Register activity of the program (data exchanged), which stops the virtual clock
+//  NOTE: the emulator calls this for each byte read or written, so the
+//        transfers are instantaneous (the latencies of the emulator remain)
+void host_clock_activity(void){
+  clock_idle = false; // reset
+}
+
+// --------------------------------------------------
+
+// Advance the virtual clock
+//  @param (duration) : the time to advance in miliseconds [uint32_t]
+//  NOTE: the timers up to the new time are called
+void host_clock_advance(uint32_t duration){
+  if(clock_virtual){
+    host_clock_forward(duration * 1000ULL);
+  }
+}
+
+// --------------------------------------------------
+
+// Call a function at a time of the virtual clock
+//  @param (time)     : the time of <millis()> [uint32_t]
+//         (callback) : the function to call [HostTimerCallback]
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns false if the virtual clock is disabled or the time has passed [bool]
+//  NOTE: the timers with the same time are called in the order of creation
+bool host_clock_at(uint32_t time, HostTimerCallback callback, void *context){
+  if(!clock_virtual || !callback || ((time * 1000ULL) < clock_time)){
+    return false;
+  }
+  clock_timers.insert(std::make_pair(time, std::make_pair(callback, context)));
+  return true;
+}
+
+// --------------------------------------------------
+
+// Check if the virtual clock is enabled
+//  @returns [bool]
+bool host_clock_is_virtual(void){
+  return clock_virtual;
+}
+
+// --------------------------------------------------
+
+// Register a poll of the program (reading the time or checking for data)
+//  NOTE: polling twice without activity means that the program is waiting,
+//        so the virtual clock advances 1 ms
+void host_clock_poll(void){
+  if(clock_virtual){
+    if(clock_idle){
+      host_clock_forward(1000);
+    }
+    clock_idle = true; // set
+  }
+}
+
+// --------------------------------------------------
+
+// Get the time without side effects (it doesn't count as a reading of the program)
+//  @returns the time of <millis()> [uint32_t]
+//  NOTE: used by the emulator, so that only the program advances the virtual clock
+uint32_t host_clock_millis(void){
+  return host_time() / 1000;
+}
+
+// --------------------------------------------------
+
+// Enable the virtual clock
+//  @param (enabled) : true to use the virtual clock, false to use the real clock [bool]
+//  NOTE: the virtual clock starts at 0 and advances only with <delay()>, with
+//        <host_clock_advance()> and while the program is waiting (see <millis()>),
+//        so the results are reproducible and the waits take no real time
+//  NOTE: call it before using the library (the time restarts at 0)
+void host_clock_virtual(bool enabled){
+  clock_virtual = enabled;
+  clock_idle = false;
+  clock_time = 0;
+  clock_timers.clear();
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// NOTE: the Arduino core prints the digits in upper case (unlike <itoa()>)
+size_t Print::print(long value, int base){
+  char str[8 * sizeof(long) + 2];
+  ltoa(value, str, base);
+  for(char *c=str ; *c ; c++){
+    *c = toupper(*c);
+  }
+  return write(str);
+}
+
+size_t Print::print(unsigned long value, int base){
+  char str[8 * sizeof(long) + 1];
+  ultoa(value, str, base);
+  for(char *c=str ; *c ; c++){
+    *c = toupper(*c);
+  }
+  return write(str);
+}
+
+size_t Print::print(double value, int digits){
+  char str[48];
+  snprintf(str, sizeof(str), "%.*f", digits, value);
+  return write(str);
+}
+
+// --------------------------------------------------
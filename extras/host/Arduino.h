@@ -0,0 +1,115 @@
+#ifndef ARDUINO_HOST_H
+#define ARDUINO_HOST_H
+
+/*******************************************************************************
+* RoboCore Arduino Host Shim (v1.1)
+*
+* Minimal Arduino core to compile the library on a computer (Linux), so that
+* it can be tested with the emulator of the module.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+extern "C" {
+  #include <ctype.h>
+  #include <stdint.h>
+  #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+}
+
+// --------------------------------------------------
+// Constants
+
+#define LOW           0x0
+#define HIGH          0x1
+
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+
+#define BIN   2
+#define OCT   8
+#define DEC  10
+#define HEX  16
+
+#define HOST_PIN_COUNT  256
+
+// --------------------------------------------------
+// Program memory (the computer has a single address space)
+
+#define PROGMEM
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t *>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t *>(address))
+
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper *>(string))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// --------------------------------------------------
+// Functions
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t);
+void delayMicroseconds(uint32_t);
+void yield(void);
+
+void pinMode(uint8_t, uint8_t);
+void digitalWrite(uint8_t, uint8_t);
+int digitalRead(uint8_t);
+
+long random(long);
+long random(long, long);
+void randomSeed(unsigned long);
+
+char* itoa(int, char *, int);
+char* ltoa(long, char *, int);
+char* utoa(unsigned int, char *, int);
+char* ultoa(unsigned long, char *, int);
+
+// --------------------------------------------------
+// Functions (host only)
+
+typedef void (*HostPinListener)(uint8_t pin, uint8_t value, void *context);
+typedef void (*HostTimerCallback)(void *context);
+
+void host_set_pin_listener(HostPinListener, void * = nullptr);
+
+void host_clock_activity(void);
+void host_clock_advance(uint32_t);
+bool host_clock_at(uint32_t, HostTimerCallback, void * = nullptr);
+bool host_clock_is_virtual(void);
+uint32_t host_clock_millis(void);
+void host_clock_poll(void);
+void host_clock_virtual(bool);
+
+// --------------------------------------------------
+
+#include "WString.h"
+#include "Stream.h"
+
+// --------------------------------------------------
+
+#endif // ARDUINO_HOST_H
@@ -0,0 +1,86 @@
+#ifndef FILE_LOG_STORAGE_H
+#define FILE_LOG_STORAGE_H
+
+/*******************************************************************************
+* RoboCore File Log Storage (v1.0)
+* 
+* Storage of the uplink log in a file, to test the log on a computer (Linux).
+* 
+* Copyright 2022 RoboCore.
+* 
+* 
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+* 
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+#include <stdio.h>
+
+#include "UplinkLog.h"
+
+// -----------------------------------------------------------------
+
+// Storage of the log in a file of fixed size
+//  NOTE: the file is created (filled with 0xFF, as an erased memory) if it doesn't exist
+//  NOTE: each write is flushed, so that the file can be reopened as after a reset
+class FileLogStorage : public LogStorage {
+  public:
+    FileLogStorage(const char *path, uint32_t size) :
+      _size(size)
+      {
+      _file = fopen(path, "r+b");
+      if(!_file){
+        _file = fopen(path, "w+b");
+        for(uint32_t i=0 ; _file && (i < _size) ; i++){
+          fputc(0xFF, _file);
+        }
+      }
+    }
+
+    ~FileLogStorage(){
+      if(_file){
+        fclose(_file);
+      }
+    }
+
+    bool read(uint32_t address, uint8_t *data, uint16_t length) override {
+      if(!_file || ((address + length) > _size) || (fseek(_file, address, SEEK_SET) != 0)){
+        return false;
+      }
+      return fread(data, 1, length, _file) == length;
+    }
+
+    uint32_t size(void) override {
+      return _size;
+    }
+
+    bool write(uint32_t address, const uint8_t *data, uint16_t length) override {
+      if(!_file || ((address + length) > _size) || (fseek(_file, address, SEEK_SET) != 0)){
+        return false;
+      }
+      bool res = (fwrite(data, 1, length, _file) == length);
+      return (fflush(_file) == 0) && res;
+    }
+
+  private:
+    FILE *_file;
+    uint32_t _size;
+};
+
+// -----------------------------------------------------------------
+
+#endif // FILE_LOG_STORAGE_H
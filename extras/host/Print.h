@@ -0,0 +1,77 @@
+#ifndef PRINT_HOST_H
+#define PRINT_HOST_H
+
+/*******************************************************************************
+* RoboCore Arduino Host Shim - Print (v1.0)
+*
+* Subset of the Arduino Print class.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+extern "C" {
+  #include <stddef.h>
+  #include <stdint.h>
+  #include <string.h>
+}
+
+#include "WString.h"
+
+class __FlashStringHelper;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+class Print {
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *data, size_t length){
+      size_t n = 0;
+      for(size_t i=0 ; i < length ; i++){
+        n += write(data[i]);
+      }
+      return n;
+    }
+    size_t write(const char *str){ return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+    size_t write(const char *data, size_t length){ return write(reinterpret_cast<const uint8_t *>(data), length); }
+
+    size_t print(const __FlashStringHelper *str){ return write(reinterpret_cast<const char *>(str)); }
+    size_t print(const String &str){ return write(str.c_str()); }
+    size_t print(const char *str){ return write(str); }
+    size_t print(char c){ return write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned char value, int base = 10){ return print(static_cast<unsigned long>(value), base); }
+    size_t print(int value, int base = 10){ return print(static_cast<long>(value), base); }
+    size_t print(unsigned int value, int base = 10){ return print(static_cast<unsigned long>(value), base); }
+    size_t print(long value, int base = 10);
+    size_t print(unsigned long value, int base = 10);
+    size_t print(double value, int digits = 2);
+
+    size_t println(void){ return write("\r\n"); }
+    template <typename T> size_t println(const T &value){ size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(const T &value, int format){ size_t n = print(value, format); return n + println(); }
+};
+
+// --------------------------------------------------
+
+#endif // PRINT_HOST_H
@@ -0,0 +1,728 @@
+/*******************************************************************************
+* RoboCore SMW_SX1276M0 Emulator (v1.0)
+*
+* Emulator of the SMW_SX1276M0 module, to test the library on a computer
+* (Linux) without the hardware.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+#include "SMW_SX1276M0_Emulator.h"
+
+// --------------------------------------------------
+// Constants
+
+// types of the commands
+#define EMULATOR_TYPE_HEX        0 // parameter with a fixed number of hexadecimal characters
+#define EMULATOR_TYPE_NUMBER     1 // parameter with a maximum value
+#define EMULATOR_TYPE_READ_ONLY  2
+#define EMULATOR_TYPE_ACTION     3
+
+// types of the scheduled actions
+#define EMULATOR_ACTION_OUTPUT    0 // send the data
+#define EMULATOR_ACTION_JOINED    1 // join accept received
+#define EMULATOR_ACTION_DOWNLINK  2 // downlink received
+#define EMULATOR_ACTION_WAKEUP    3 // alarm of the RTC
+
+const char* const EMULATOR_STATUS_OK = RSPNS_OK;
+const char* const EMULATOR_STATUS_FAILED = RSPNS_FAILED;
+const char* const EMULATOR_STATUS_NOT_FOUND = "Command Not Found";
+const char* const EMULATOR_VERSION = "1.0.0";
+const char* const EMULATOR_BANNER = "*** SMW_SX1276M0 Emulator ***";
+
+// commands of the module (with the default values)
+struct EmulatorCommand {
+  const char *command;
+  uint8_t type;
+  uint32_t limit; // the size of the hexadecimal parameter or the maximum value
+  const char *value;
+};
+
+static const EmulatorCommand EMULATOR_COMMANDS[] = {
+  { CMD_DEVEUI , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_DEVEUI , "0004A30B00000000" },
+  { CMD_APPEUI , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_APPEUI , "0000000000000000" },
+  { CMD_APPKEY , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_APPKEY , "00000000000000000000000000000000" },
+  { CMD_NJM , EMULATOR_TYPE_NUMBER , SMW_SX1276M0_JOIN_MODE_P2P , "1" },
+  { CMD_NJS , EMULATOR_TYPE_READ_ONLY , 0 , "0" },
+  { CMD_JOIN , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_AJOIN , EMULATOR_TYPE_NUMBER , 1 , "0" },
+  { CMD_NWKSKEY , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_NWKSKEY , "00000000000000000000000000000000" },
+  { CMD_APPSKEY , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_APPSKEY , "00000000000000000000000000000000" },
+  { CMD_DADDR , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_DEVADDR , "00000000" },
+  { CMD_SEND , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_SENDB , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_RECV , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_RECVB , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_RSSI , EMULATOR_TYPE_READ_ONLY , 0 , "-50" },
+  { CMD_SNR , EMULATOR_TYPE_READ_ONLY , 0 , "9" },
+  { CMD_REGION , EMULATOR_TYPE_NUMBER , SMW_SX1276M0_REGION_COUNT - 1 , "1" },
+  { CMD_ADR , EMULATOR_TYPE_NUMBER , 1 , "0" },
+  { CMD_DR , EMULATOR_TYPE_NUMBER , 7 , "0" },
+  { CMD_NUM_RETRIES , EMULATOR_TYPE_NUMBER , 8 , "1" },
+  { CMD_TXP , EMULATOR_TYPE_NUMBER , 10 , "0" },
+  { CMD_RESET , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_VERSION , EMULATOR_TYPE_READ_ONLY , 0 , EMULATOR_VERSION },
+  { CMD_CONFIRMATION , EMULATOR_TYPE_NUMBER , 1 , "0" },
+  { CMD_SLEEP , EMULATOR_TYPE_ACTION , 0 , nullptr },
+  { CMD_ALARM , EMULATOR_TYPE_NUMBER , 999999999 , "0" },
+  { CMD_ECHO , EMULATOR_TYPE_NUMBER , 1 , "0" },
+  { CMD_P2P_DADDR , EMULATOR_TYPE_HEX , SMW_SX1276M0_SIZE_DEVADDR , "00000000" },
+  { CMD_P2P_WORD , EMULATOR_TYPE_NUMBER , 255 , "52" }
+};
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Find a command of the module
+//  @param (command) : the name of the command [std::string]
+//  @returns the command, or nullptr if not found [EmulatorCommand *]
+static const EmulatorCommand* find_command(const std::string &command){
+  for(const EmulatorCommand &entry : EMULATOR_COMMANDS){
+    if(command == entry.command){
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+// --------------------------------------------------
+
+// Encode bytes in hexadecimal (upper case)
+//  @param (data) : the bytes to encode [std::string]
+//  @returns the hexadecimal characters [std::string]
+static std::string encode_hex(const std::string &data){
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  std::string res;
+  for(unsigned char c : data){
+    res += HEX_DIGITS[c >> 4];
+    res += HEX_DIGITS[c & 0x0F];
+  }
+  return res;
+}
+
+// --------------------------------------------------
+
+// Decode hexadecimal characters
+//  @param (hex)  : the characters to decode [std::string]
+//         (data) : the string to store the bytes [std::string (&)]
+//  @returns false if the characters are not valid [bool]
+static bool decode_hex(const std::string &hex, std::string &data){
+  if(hex.size() % 2){
+    return false;
+  }
+  data.clear();
+  for(size_t i=0 ; i < hex.size() ; i += 2){
+    if(!isxdigit(hex[i]) || !isxdigit(hex[i+1])){
+      return false;
+    }
+    data += static_cast<char>(strtoul(hex.substr(i, 2).c_str(), nullptr, 16));
+  }
+  return true;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Constructor
+//  NOTE: the module starts ready (as if powered long ago), call <reset()> to boot it
+SMW_SX1276M0_Emulator::SMW_SX1276M0_Emulator(void) :
+  _line_overflow(false),
+  _received{ 0 , std::string() , false },
+  _uplink{ 0 , std::string() , false , false , 0 },
+  _latency(SMW_SX1276M0_EMULATOR_LATENCY),
+  _boot_time(SMW_SX1276M0_EMULATOR_BOOT),
+  _join_time(SMW_SX1276M0_EMULATOR_JOIN),
+  _uplink_time(SMW_SX1276M0_EMULATOR_UPLINK),
+  _ready_time(0),
+  _ack_loss(0),
+  _join_accept(true),
+  _sleeping(false),
+  _pin_reset(-1),
+  _command_count(0),
+  _uplink_count(0)
+  {
+  for(const EmulatorCommand &entry : EMULATOR_COMMANDS){
+    if(entry.value){
+      _parameters[entry.command] = entry.value;
+    }
+  }
+}
+
+// --------------------------------------------------
+
+// Destructor
+SMW_SX1276M0_Emulator::~SMW_SX1276M0_Emulator(){
+  if(_pin_reset >= 0){
+    host_set_pin_listener(nullptr);
+  }
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Check if there is data for the library
+//  @returns the number of bytes available [int]
+//  NOTE: no data counts as a poll of the virtual clock (see <host_clock_poll()>)
+int SMW_SX1276M0_Emulator::available(void){
+  _update();
+  if(_rx.empty()){
+    host_clock_poll();
+  }
+  return _rx.size();
+}
+
+// --------------------------------------------------
+
+// Check the next byte for the library
+//  @returns the byte, or -1 if none [int]
+int SMW_SX1276M0_Emulator::peek(void){
+  _update();
+  if(_rx.empty()){
+    return -1;
+  }
+  return static_cast<uint8_t>(_rx[0]);
+}
+
+// --------------------------------------------------
+
+// Read the next byte for the library
+//  @returns the byte, or -1 if none [int]
+int SMW_SX1276M0_Emulator::read(void){
+  int c = peek();
+  if(c >= 0){
+    _rx.erase(0, 1);
+    host_clock_activity();
+  }
+  return c;
+}
+
+// --------------------------------------------------
+
+// Receive a byte from the library
+//  @param (c) : the byte received [uint8_t]
+//  @returns the number of bytes written [size_t]
+//  NOTE: the commands end with CR (LF is ignored)
+size_t SMW_SX1276M0_Emulator::write(uint8_t c){
+  host_clock_activity();
+  _update();
+
+  // echo the characters
+  if((_parameters[CMD_ECHO] == "1") && isReady()){
+    _rx += static_cast<char>(c);
+  }
+
+  if(c == CHAR_CR){
+    if(!_line_overflow){
+      _handle(_line);
+    }
+    _line.clear();
+    _line_overflow = false; // reset
+  } else if(c != CHAR_LF){
+    if(_line.size() < SMW_SX1276M0_EMULATOR_LINE_SIZE){
+      _line += static_cast<char>(c);
+    } else {
+      _line_overflow = true; // set
+    }
+  }
+  return 1;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Reset the emulator with the reset pin of the library (active HIGH)
+//  @param (pin) : the pin given to the library [uint8_t]
+//  NOTE: the module reboots at the end of the pulse
+//  NOTE: there is a single listener for the pins, so only one emulator can be attached
+void SMW_SX1276M0_Emulator::attachResetPin(uint8_t pin){
+  _pin_reset = pin;
+  host_set_pin_listener(_pin_changed, this);
+}
+
+// --------------------------------------------------
+
+// Set the number of confirmed uplinks without acknowledgement
+//  @param (count) : the number of the next confirmed uplinks to fail [uint8_t]
+void SMW_SX1276M0_Emulator::setAckLoss(uint8_t count){
+  _ack_loss = count;
+}
+
+// --------------------------------------------------
+
+// Set the time to boot
+//  @param (duration) : the time from the reset to the first reply [ms] [uint32_t]
+void SMW_SX1276M0_Emulator::setBootTime(uint32_t duration){
+  _boot_time = duration;
+}
+
+// --------------------------------------------------
+
+// Set if the network accepts the join requests
+//  @param (accept) : false to ignore the requests [bool]
+void SMW_SX1276M0_Emulator::setJoinAccept(bool accept){
+  _join_accept = accept;
+}
+
+// --------------------------------------------------
+
+// Set the time to join (OTAA)
+//  @param (duration) : the time from the request to the JOINED event [ms] [uint32_t]
+void SMW_SX1276M0_Emulator::setJoinTime(uint32_t duration){
+  _join_time = duration;
+}
+
+// --------------------------------------------------
+
+// Set the time to reply to a command
+//  @param (command)  : the command (CMD_*), or nullptr for the default [char *]
+//         (duration) : the time to reply [ms] [uint32_t]
+//  NOTE: use CMD_AT for the ping
+//  NOTE: the time of the uplinks is added to the latency of the confirmed SEND and SENDB
+void SMW_SX1276M0_Emulator::setLatency(const char *command, uint32_t duration){
+  if(command){
+    _latencies[command] = duration;
+  } else {
+    _latency = duration;
+  }
+}
+
+// --------------------------------------------------
+
+// Set the signal of the downlinks
+//  @param (rssi) : the RSSI [dBm] [int16_t]
+//         (snr)  : the SNR [dB] [int8_t]
+void SMW_SX1276M0_Emulator::setSignal(int16_t rssi, int8_t snr){
+  _parameters[CMD_RSSI] = std::to_string(rssi);
+  _parameters[CMD_SNR] = std::to_string(snr);
+}
+
+// --------------------------------------------------
+
+// Set the time of the uplinks
+//  @param (duration) : the time of the transmission and of the receive windows [ms] [uint32_t]
+//  NOTE: the downlinks are received after this time, and the confirmed uplinks are replied
+void SMW_SX1276M0_Emulator::setUplinkTime(uint32_t duration){
+  _uplink_time = duration;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Queue a text downlink
+//  @param (port) : the application port (1 to 223) [uint8_t]
+//         (data) : the text [char *]
+//  @returns false if the port is not valid [bool]
+//  NOTE: the downlink is received after the next uplink (class A)
+bool SMW_SX1276M0_Emulator::downlinkT(uint8_t port, const char *data){
+  if((port < 1) || (port > 223) || !data){
+    return false;
+  }
+  _downlinks.push_back({ port , data , false });
+  return true;
+}
+
+// --------------------------------------------------
+
+// Queue a binary downlink
+//  @param (port)   : the application port (1 to 223) [uint8_t]
+//         (data)   : the bytes [uint8_t *]
+//         (length) : the number of bytes [size_t]
+//  @returns false if the port is not valid [bool]
+//  NOTE: the downlink is received after the next uplink (class A)
+bool SMW_SX1276M0_Emulator::downlinkX(uint8_t port, const uint8_t *data, size_t length){
+  if((port < 1) || (port > 223) || (!data && length)){
+    return false;
+  }
+  _downlinks.push_back({ port , std::string(reinterpret_cast<const char *>(data), length) , true });
+  return true;
+}
+
+// --------------------------------------------------
+
+// Send a line to the library
+//  @param (line)  : the line, without the line ending [char *]
+//         (delay) : the time to wait before sending [ms] [uint32_t] (default: 0)
+void SMW_SX1276M0_Emulator::emit(const char *line, uint32_t delay){
+  _schedule(delay, EMULATOR_ACTION_OUTPUT, std::string(line) + "\r\n");
+}
+
+// --------------------------------------------------
+
+// Power cycle the module
+//  NOTE: the pending replies and events are lost, but the parameters are kept
+void SMW_SX1276M0_Emulator::reset(void){
+  _actions.clear();
+  _rx.clear();
+  _boot(0);
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Get the value of a parameter
+//  @param (command) : the command of the parameter (CMD_*) [char *]
+//  @returns the value, or nullptr if not a parameter [char *]
+const char* SMW_SX1276M0_Emulator::get(const char *command){
+  std::map<std::string, std::string>::const_iterator it = _parameters.find(command);
+  if(it == _parameters.end()){
+    return nullptr;
+  }
+  return it->second.c_str();
+}
+
+// --------------------------------------------------
+
+// Get the number of commands handled
+//  @returns the number of commands since the creation [uint32_t]
+//  NOTE: the commands ignored while booting or sleeping are not counted
+uint32_t SMW_SX1276M0_Emulator::getCommandCount(void){
+  return _command_count;
+}
+
+// --------------------------------------------------
+
+// Get the last uplink
+//  @returns the uplink [EmulatedUplink (&)]
+const EmulatedUplink& SMW_SX1276M0_Emulator::getLastUplink(void){
+  return _uplink;
+}
+
+// --------------------------------------------------
+
+// Get the time of the next scheduled action (reply, event or state change)
+//  @returns the time [ms], or UINT32_MAX if there is none [uint32_t]
+uint32_t SMW_SX1276M0_Emulator::getNextTime(void){
+  if(_actions.empty()){
+    return UINT32_MAX;
+  }
+  return _actions.front().time;
+}
+
+// --------------------------------------------------
+
+// Get the number of uplinks sent
+//  @returns the number of uplinks since the creation [uint32_t]
+uint32_t SMW_SX1276M0_Emulator::getUplinkCount(void){
+  return _uplink_count;
+}
+
+// --------------------------------------------------
+
+// Check if the module joined the network
+//  @returns [bool]
+bool SMW_SX1276M0_Emulator::isJoined(void){
+  _update();
+  return _parameters[CMD_NJS] == "1";
+}
+
+// --------------------------------------------------
+
+// Check if the module replies to the commands (not booting nor sleeping)
+//  @returns [bool]
+bool SMW_SX1276M0_Emulator::isReady(void){
+  return !isSleeping() && (static_cast<int32_t>(host_clock_millis() - _ready_time) >= 0);
+}
+
+// --------------------------------------------------
+
+// Check if the module is sleeping
+//  @returns [bool]
+bool SMW_SX1276M0_Emulator::isSleeping(void){
+  _update();
+  return _sleeping;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Boot the module
+//  @param (delay) : the time to wait before the boot [ms] [uint32_t]
+//  NOTE: the boot banner is sent at the start of the boot
+void SMW_SX1276M0_Emulator::_boot(uint32_t delay){
+  _sleeping = false; // reset
+  _parameters[CMD_NJS] = "0"; // the session is lost
+  _ready_time = host_clock_millis() + delay + _boot_time;
+
+  std::string banner(reinterpret_cast<const char *>(RSPNS_BOOT), sizeof(RSPNS_BOOT));
+  banner += EMULATOR_BANNER;
+  banner += "\r\n";
+  _schedule(delay, EMULATOR_ACTION_OUTPUT, banner);
+}
+
+// --------------------------------------------------
+
+// Handle a command
+//  @param (line) : the command, without the line ending [std::string]
+void SMW_SX1276M0_Emulator::_handle(const std::string &line){
+  if(!isReady()){
+    return; // ignored
+  }
+  _command_count++;
+
+  // check for the ping
+  if(line == CMD_AT){
+    _reply(_latency_of(CMD_AT), EMULATOR_STATUS_OK);
+    return;
+  }
+
+  // split the command and the parameter
+  std::string prefix = std::string(CMD_AT) + CHAR_PLUS;
+  if(line.compare(0, prefix.size(), prefix) != 0){
+    _reply(_latency, EMULATOR_STATUS_NOT_FOUND);
+    return;
+  }
+  size_t separator = line.find(CHAR_SPACE, prefix.size());
+  std::string name = line.substr(prefix.size(), separator - prefix.size());
+  bool has_parameter = (separator != std::string::npos);
+  std::string parameter = has_parameter ? line.substr(separator + 1) : std::string();
+
+  const EmulatorCommand *command = find_command(name);
+  if(!command){
+    _reply(_latency, EMULATOR_STATUS_NOT_FOUND);
+    return;
+  }
+  uint32_t latency = _latency_of(command->command);
+
+  // check the parameters
+  if(command->type == EMULATOR_TYPE_ACTION){
+    // continue below
+  } else if(!has_parameter){
+    _reply(latency, EMULATOR_STATUS_OK, _parameters[command->command]);
+    return;
+  } else if(command->type == EMULATOR_TYPE_HEX){
+    bool valid = (parameter.size() == command->limit);
+    for(size_t i=0 ; valid && (i < parameter.size()) ; i++){
+      valid = isxdigit(parameter[i]);
+    }
+    if(valid){
+      _parameters[command->command] = parameter;
+    }
+    _reply(latency, valid ? EMULATOR_STATUS_OK : EMULATOR_STATUS_FAILED);
+    return;
+  } else if(command->type == EMULATOR_TYPE_NUMBER){
+    bool valid = !parameter.empty() && (parameter.size() <= 10);
+    for(size_t i=0 ; valid && (i < parameter.size()) ; i++){
+      valid = isdigit(parameter[i]);
+    }
+    uint32_t value = valid ? strtoul(parameter.c_str(), nullptr, 10) : 0;
+    if(valid && (value <= command->limit)){
+      _parameters[command->command] = std::to_string(value);
+      _reply(latency, EMULATOR_STATUS_OK);
+      if((name == CMD_REGION) || (name == CMD_NJM)){
+        _boot(latency + 1); // the module resets to apply the parameter
+      }
+    } else {
+      _reply(latency, EMULATOR_STATUS_FAILED);
+    }
+    return;
+  } else {
+    _reply(latency, EMULATOR_STATUS_FAILED); // read only
+    return;
+  }
+
+  // execute the actions
+  if(name == CMD_JOIN){
+    _reply(latency, EMULATOR_STATUS_OK);
+    std::string event = std::string(RSPNS_EVENT) + CHAR_SPACE + RSPNS_JOINED + "\r\n";
+    uint8_t mode = atoi(_parameters[CMD_NJM].c_str());
+    if(mode == SMW_SX1276M0_JOIN_MODE_ABP){
+      _schedule(latency, EMULATOR_ACTION_JOINED, event);
+    } else if((mode == SMW_SX1276M0_JOIN_MODE_OTAA) && _join_accept){
+      _schedule(latency + _join_time, EMULATOR_ACTION_JOINED, event);
+    }
+  } else if((name == CMD_SEND) || (name == CMD_SENDB)){
+    _send(name, parameter);
+  } else if((name == CMD_RECV) || (name == CMD_RECVB)){
+    if(_received.port == 0){
+      _reply(latency, EMULATOR_STATUS_OK); // nothing received
+    } else {
+      std::string data = (name == CMD_RECVB) ? encode_hex(_received.data) : _received.data;
+      _reply(latency, EMULATOR_STATUS_OK, std::to_string(_received.port) + CHAR_COLON + data);
+    }
+  } else if(name == CMD_RESET){
+    _actions.clear(); // the pending replies and events are lost
+    _reply(latency, EMULATOR_STATUS_OK);
+    _boot(latency + 1);
+  } else if(name == CMD_SLEEP){
+    _reply(latency, EMULATOR_STATUS_OK);
+    _schedule(latency, EMULATOR_ACTION_OUTPUT, std::string(RSPNS_EVENT) + CHAR_SPACE + RSPNS_SLEEP + "\r\n");
+    _sleeping = true; // set (the next commands are ignored)
+    uint32_t alarm = strtoul(_parameters[CMD_ALARM].c_str(), nullptr, 10);
+    if(alarm > 0){
+      _schedule(latency + (alarm * 1000), EMULATOR_ACTION_WAKEUP); // [s]
+    }
+  }
+}
+
+// --------------------------------------------------
+
+// Get the time to reply to a command
+//  @param (command) : the command [char *]
+//  @returns the time [ms] [uint32_t]
+uint32_t SMW_SX1276M0_Emulator::_latency_of(const char *command){
+  std::map<std::string, uint32_t>::const_iterator it = _latencies.find(command);
+  if(it == _latencies.end()){
+    return _latency;
+  }
+  return it->second;
+}
+
+// --------------------------------------------------
+
+// Reply to a command
+//  @param (delay)  : the time to wait [ms] [uint32_t]
+//         (status) : the status of the response [char *]
+//         (data)   : the data before the status (if any) [std::string]
+void SMW_SX1276M0_Emulator::_reply(uint32_t delay, const char *status, const std::string &data){
+  std::string response;
+  if(!data.empty()){
+    response = data + "\r\n";
+  }
+  response += CHAR_LT;
+  response += status;
+  response += CHAR_GT;
+  response += "\r\n";
+  _schedule(delay, EMULATOR_ACTION_OUTPUT, response);
+}
+
+// --------------------------------------------------
+
+// Schedule an action
+//  @param (delay) : the time to wait [ms] [uint32_t]
+//         (type)  : the type of the action [uint8_t]
+//         (data)  : the data to send (if any) [std::string]
+//  NOTE: the actions with the same time keep their order
+void SMW_SX1276M0_Emulator::_schedule(uint32_t delay, uint8_t type, const std::string &data){
+  Action action = { host_clock_millis() + delay , type , data };
+  std::deque<Action>::iterator it = _actions.end();
+  while((it != _actions.begin()) && (static_cast<int32_t>((it - 1)->time - action.time) > 0)){
+    it--;
+  }
+  _actions.insert(it, action);
+}
+
+// --------------------------------------------------
+
+// Send an uplink
+//  @param (command)   : the command (SEND or SENDB) [std::string]
+//         (parameter) : the parameter of the command (<port>:<data>) [std::string]
+void SMW_SX1276M0_Emulator::_send(const std::string &command, const std::string &parameter){
+  uint32_t latency = _latency_of(command.c_str());
+
+  // parse the parameter
+  size_t separator = parameter.find(CHAR_COLON);
+  uint32_t port = (separator == std::string::npos) ? 0 : strtoul(parameter.substr(0, separator).c_str(), nullptr, 10);
+  std::string data;
+  bool hex = (command == CMD_SENDB);
+  bool valid = (port >= 1) && (port <= 223);
+  if(valid){
+    data = parameter.substr(separator + 1);
+    if(hex){
+      valid = decode_hex(parameter.substr(separator + 1), data);
+    }
+  }
+
+  // check the state
+  uint8_t mode = atoi(_parameters[CMD_NJM].c_str());
+  uint8_t region = atoi(_parameters[CMD_REGION].c_str());
+  uint8_t dr = atoi(_parameters[CMD_DR].c_str());
+  if(!valid || ((mode != SMW_SX1276M0_JOIN_MODE_P2P) && (_parameters[CMD_NJS] != "1")) || (data.size() > max_payload(region, dr))){
+    _reply(latency, EMULATOR_STATUS_FAILED);
+    return;
+  }
+
+  // register the uplink
+  bool confirmed = (_parameters[CMD_CONFIRMATION] == "1");
+  _uplink = { static_cast<uint8_t>(port) , data , hex , confirmed , host_clock_millis() };
+  _uplink_count++;
+
+  // reply (the confirmed uplinks only after the receive windows)
+  if(!confirmed){
+    _reply(latency, EMULATOR_STATUS_OK);
+  } else if(_ack_loss > 0){
+    _ack_loss--;
+    _reply(latency + _uplink_time, EMULATOR_STATUS_FAILED);
+    return;
+  } else {
+    _reply(latency + _uplink_time, EMULATOR_STATUS_OK);
+  }
+
+  // receive the next downlink
+  if(!_downlinks.empty()){
+    const Downlink &downlink = _downlinks.front();
+    std::string event = std::string(RSPNS_EVENT) + CHAR_SPACE + RSPNS_RECV;
+    event += downlink.hex ? "B " : " ";
+    event += std::to_string(downlink.port) + CHAR_COLON;
+    event += downlink.hex ? encode_hex(downlink.data) : downlink.data;
+    event += "\r\n";
+
+    // store the port and the data before the event
+    std::string stored(1, static_cast<char>(downlink.port));
+    stored += downlink.data;
+    _schedule(latency + _uplink_time, EMULATOR_ACTION_DOWNLINK, stored);
+    _schedule(latency + _uplink_time, EMULATOR_ACTION_OUTPUT, event);
+    _downlinks.pop_front();
+  }
+}
+
+// --------------------------------------------------
+
+// Execute the actions up to the current time
+void SMW_SX1276M0_Emulator::_update(void){
+  uint32_t now = host_clock_millis();
+  while(!_actions.empty() && (static_cast<int32_t>(now - _actions.front().time) >= 0)){
+    Action action = _actions.front();
+    _actions.pop_front();
+
+    switch(action.type){
+      case EMULATOR_ACTION_OUTPUT:
+        _rx += action.data;
+        break;
+
+      case EMULATOR_ACTION_JOINED:
+        _parameters[CMD_NJS] = "1";
+        _rx += action.data;
+        break;
+
+      case EMULATOR_ACTION_DOWNLINK:
+        _received.port = static_cast<uint8_t>(action.data[0]);
+        _received.data = action.data.substr(1);
+        break;
+
+      case EMULATOR_ACTION_WAKEUP:
+        _boot(0);
+        break;
+    }
+  }
+}
+
+// --------------------------------------------------
+
+// Handle the change of an output pin
+//  @param (pin)     : the pin [uint8_t]
+//         (value)   : the new value [uint8_t]
+//         (context) : the emulator [void *]
+void SMW_SX1276M0_Emulator::_pin_changed(uint8_t pin, uint8_t value, void *context){
+  SMW_SX1276M0_Emulator *emulator = static_cast<SMW_SX1276M0_Emulator *>(context);
+  if((pin == emulator->_pin_reset) && (value == LOW)){
+    emulator->reset(); // end of the pulse
+  }
+}
+
+// --------------------------------------------------
@@ -0,0 +1,151 @@
+#ifndef SMW_SX1276M0_EMULATOR_H
+#define SMW_SX1276M0_EMULATOR_H
+
+/*******************************************************************************
+* RoboCore SMW_SX1276M0 Emulator (v1.0)
+*
+* Emulator of the SMW_SX1276M0 module, to test the library on a computer
+* (Linux) without the hardware.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include "Arduino.h"
+#include "RoboCore_SMW_SX1276M0.h"
+
+// --------------------------------------------------
+// Constants
+
+#define SMW_SX1276M0_EMULATOR_LATENCY       5 // [ms] (default time to reply to a command)
+#define SMW_SX1276M0_EMULATOR_BOOT        500 // [ms] (from the reset to the first reply)
+#define SMW_SX1276M0_EMULATOR_JOIN       5000 // [ms] (from the join request to the join accept)
+#define SMW_SX1276M0_EMULATOR_UPLINK     1500 // [ms] (transmission and receive windows)
+#define SMW_SX1276M0_EMULATOR_LINE_SIZE  1024 // [bytes] (the longer commands are discarded)
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Last uplink received by the emulator
+struct EmulatedUplink {
+  uint8_t port;
+  std::string data; // the bytes sent (decoded if hexadecimal)
+  bool hex; // true if sent with SENDB
+  bool confirmed;
+  uint32_t time; // [ms] the time of the command
+};
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+class SMW_SX1276M0_Emulator : public Stream {
+  public:
+    SMW_SX1276M0_Emulator(void);
+    ~SMW_SX1276M0_Emulator();
+
+    // Stream
+    int available(void) override;
+    int peek(void) override;
+    int read(void) override;
+    size_t write(uint8_t) override;
+    using Print::write;
+
+    // configuration
+    void attachResetPin(uint8_t);
+    void setAckLoss(uint8_t);
+    void setBootTime(uint32_t);
+    void setJoinAccept(bool);
+    void setJoinTime(uint32_t);
+    void setLatency(const char *, uint32_t);
+    void setSignal(int16_t, int8_t);
+    void setUplinkTime(uint32_t);
+
+    // stimuli
+    bool downlinkT(uint8_t, const char *);
+    bool downlinkX(uint8_t, const uint8_t *, size_t);
+    void emit(const char *, uint32_t = 0);
+    void reset(void);
+
+    // state
+    const char* get(const char *);
+    uint32_t getCommandCount(void);
+    const EmulatedUplink& getLastUplink(void);
+    uint32_t getNextTime(void);
+    uint32_t getUplinkCount(void);
+    bool isJoined(void);
+    bool isReady(void);
+    bool isSleeping(void);
+
+  private:
+    // action scheduled for a time
+    struct Action {
+      uint32_t time;
+      uint8_t type;
+      std::string data;
+    };
+
+    // message waiting for the next uplink (class A)
+    struct Downlink {
+      uint8_t port;
+      std::string data;
+      bool hex;
+    };
+
+    std::deque<Action> _actions; // (sorted by time)
+    std::string _rx; // the data available to the library
+    std::string _line; // the command being received
+    bool _line_overflow;
+    std::map<std::string, std::string> _parameters;
+    std::map<std::string, uint32_t> _latencies;
+    std::deque<Downlink> _downlinks;
+    Downlink _received; // the last downlink (for RECV/RECVB)
+    EmulatedUplink _uplink;
+
+    uint32_t _latency;
+    uint32_t _boot_time;
+    uint32_t _join_time;
+    uint32_t _uplink_time;
+    uint32_t _ready_time; // [ms] the end of the boot
+    uint8_t _ack_loss;
+    bool _join_accept;
+    bool _sleeping;
+    int16_t _pin_reset;
+    uint32_t _command_count;
+    uint32_t _uplink_count;
+
+    void _boot(uint32_t);
+    void _handle(const std::string &);
+    uint32_t _latency_of(const char *);
+    void _reply(uint32_t, const char *, const std::string & = std::string());
+    void _schedule(uint32_t, uint8_t, const std::string & = std::string());
+    void _send(const std::string &, const std::string &);
+    void _update(void);
+
+    static void _pin_changed(uint8_t, uint8_t, void *);
+};
+
+// --------------------------------------------------
+
+#endif // SMW_SX1276M0_EMULATOR_H
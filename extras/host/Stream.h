@@ -0,0 +1,47 @@
+#ifndef STREAM_HOST_H
+#define STREAM_HOST_H
+
+/*******************************************************************************
+* RoboCore Arduino Host Shim - Stream (v1.0)
+*
+* Subset of the Arduino Stream class.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+#include "Arduino.h"
+#include "Print.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+class Stream : public Print {
+  public:
+    virtual int available(void) = 0;
+    virtual int peek(void) = 0;
+    virtual int read(void) = 0;
+    virtual void flush(void) {}
+};
+
+// --------------------------------------------------
+
+#endif // STREAM_HOST_H
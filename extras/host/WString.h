@@ -0,0 +1,84 @@
+#ifndef WSTRING_HOST_H
+#define WSTRING_HOST_H
+
+/*******************************************************************************
+* RoboCore Arduino Host Shim - String (v1.0)
+*
+* Subset of the Arduino String class, on top of the standard string.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+#include <string>
+
+extern "C" {
+  #include <stdint.h>
+  #include <string.h>
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+class String {
+  public:
+    String(const char *str = "") : _string(str ? str : "") {}
+    String(const std::string &str) : _string(str) {}
+    explicit String(char c) : _string(1, c) {}
+    explicit String(long value) : _string(std::to_string(value)) {}
+
+    String& operator+=(const String &str){ _string += str._string; return *this; }
+    String& operator+=(const char *str){ _string += str; return *this; }
+    String& operator+=(char c){ _string += c; return *this; }
+    bool operator==(const String &str) const { return _string == str._string; }
+    bool operator==(const char *str) const { return _string == str; }
+    bool operator!=(const String &str) const { return _string != str._string; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    const char * c_str(void) const { return _string.c_str(); }
+    char charAt(unsigned int index) const { return (index < _string.size()) ? _string[index] : 0; }
+    unsigned int length(void) const { return _string.size(); }
+
+    // Copy the characters to an array (with the terminating null character)
+    //  @param (buffer) : the array to copy to [char *]
+    //         (size)   : the size of the array [unsigned int]
+    void toCharArray(char *buffer, unsigned int size) const {
+      if(!buffer || (size == 0)){
+        return;
+      }
+      unsigned int length = (_string.size() < (size - 1)) ? _string.size() : (size - 1);
+      memcpy(buffer, _string.data(), length);
+      buffer[length] = '\0';
+    }
+
+  private:
+    std::string _string;
+};
+
+inline String operator+(const String &lhs, const String &rhs){
+  String res = lhs;
+  res += rhs;
+  return res;
+}
+
+// --------------------------------------------------
+
+#endif // WSTRING_HOST_H
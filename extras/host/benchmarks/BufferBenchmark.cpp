@@ -0,0 +1,155 @@
+/*******************************************************************************
+* Benchmark of the Buffer (v1.0)
+*
+* Compares the circular Buffer of the library with the previous
+* implementation (shift of the whole array on each read, clear of the whole
+* array on each reset), for payloads of 50 to 512 bytes.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <chrono>
+
+#include "Buffer.h"
+
+// --------------------------------------------------
+// Constants
+
+const uint16_t SIZES[] = { 50 , 128 , 255 , 512 };
+const uint32_t ITERATIONS = 20000;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Previous implementation of the Buffer (only the methods used by the parsers)
+//  NOTE: with 16-bit sizes, so that the same payloads can be compared
+class ShiftingBuffer {
+  public:
+    ShiftingBuffer(uint16_t size) : _index(0), _size(size) {
+      _buffer = new uint8_t[_size];
+      reset();
+    }
+
+    ~ShiftingBuffer(){
+      delete[] _buffer;
+    }
+
+    void append(uint8_t b){
+      if(_index < _size){
+        _buffer[_index++] = b;
+      }
+    }
+
+    uint16_t available(void){
+      return _index;
+    }
+
+    uint8_t peek(void){
+      if(_index == 0){
+        return 0;
+      }
+      return _buffer[0];
+    }
+
+    uint8_t read(void){
+      uint8_t ret = peek();
+      // shift the buffer
+      if(_index > 0){
+        for(uint16_t i=0 ; i < (_index - 1) ; i++){
+          _buffer[i] = _buffer[i+1];
+        }
+        _index--; // update
+        _buffer[_index] = 0; // reset
+      }
+      return ret;
+    }
+
+    void reset(void){
+      _index = 0;
+      for(uint16_t i=0 ; i < _size ; i++){
+        _buffer[i] = 0;
+      }
+    }
+
+  private:
+    uint16_t _index;
+    uint16_t _size;
+    uint8_t *_buffer;
+};
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Measure the time to store and to read a payload (as the parsers of the responses)
+//  @param (size) : the size of the payload [uint16_t]
+//  @returns the average time in nanoseconds [double]
+template <class B>
+double fill_and_drain(uint16_t size){
+  B buffer(size);
+  volatile uint32_t sink = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(uint32_t k=0 ; k < ITERATIONS ; k++){
+    buffer.reset();
+    for(uint16_t i=0 ; i < size ; i++){
+      buffer.append(i);
+    }
+    while(buffer.available()){
+      sink += buffer.read();
+    }
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+// --------------------------------------------------
+
+// Measure the time to reset a buffer (as before each command)
+//  @param (size) : the size of the buffer [uint16_t]
+//  @returns the average time in nanoseconds [double]
+template <class B>
+double reset(uint16_t size){
+  B buffer(size);
+  volatile uint32_t sink = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(uint32_t k=0 ; k < ITERATIONS ; k++){
+    buffer.append(k);
+    buffer.reset();
+    sink += buffer.available();
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+// --------------------------------------------------
+
+int main(void){
+  printf("Buffer benchmark (%lu iterations, average in ns)\n\n", static_cast<unsigned long>(ITERATIONS));
+  printf("  size | fill+drain: shifting   circular | reset: shifting   circular\n");
+  for(uint16_t size : SIZES){
+    printf("  %4u | %20.0f %10.0f | %15.0f %10.0f\n", size,
+      fill_and_drain<ShiftingBuffer>(size), fill_and_drain<Buffer>(size),
+      reset<ShiftingBuffer>(size), reset<Buffer>(size));
+  }
+  return 0;
+}
+
+// --------------------------------------------------
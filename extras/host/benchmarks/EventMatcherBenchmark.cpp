@@ -0,0 +1,276 @@
+/*******************************************************************************
+* Benchmark of the matcher of the unsolicited lines (v1.0)
+*
+* Compares the matcher of the library (a single automaton for all the tokens,
+* one step per byte as the line is received) with the previous implementation
+* (copy of the line and one memmem() per token at the end) and with one state
+* per token, and measures the number of lines per second parsed by <listen()>.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <chrono>
+#include <string>
+
+#include "RoboCore_SMW_SX1276M0.h"
+
+// --------------------------------------------------
+// Constants
+
+const char *LINES[] = {
+  "[EVENT] JOINED",
+  "[EVENT] RECV 2:hello world",
+  "[EVENT] RECVB 3:00112233445566778899AABBCCDDEEFF",
+  "some unrelated line 0123456789"
+};
+const uint8_t LINES_COUNT = sizeof(LINES) / sizeof(LINES[0]);
+const uint32_t ITERATIONS = 1000000;
+
+struct Token {
+  const uint8_t *data;
+  uint8_t length;
+};
+
+const Token TOKENS[SMW_SX1276M0_TOKEN_COUNT] = {
+  { reinterpret_cast<const uint8_t *>(RSPNS_EVENT) , 7 },
+  { reinterpret_cast<const uint8_t *>(RSPNS_SLEEP) , 5 },
+  { reinterpret_cast<const uint8_t *>(RSPNS_JOINED) , 6 },
+  { reinterpret_cast<const uint8_t *>(RSPNS_RECV) , 4 },
+  { RSPNS_BOOT , sizeof(RSPNS_BOOT) }
+};
+
+const uint8_t STATES = 7 + 5 + 6 + 4 + sizeof(RSPNS_BOOT) + 1;
+
+uint8_t automaton_next[STATES][256]; // (a copy of the automaton of the library, built at run time)
+uint8_t automaton_found[STATES];
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module that sends the lines in a loop
+class LineModule : public Stream {
+  public:
+    LineModule() : written(0), _line(0), _index(0) {}
+
+    int available(void) override {
+      return 1; // always
+    }
+
+    int peek(void) override {
+      const char *line = LINES[_line];
+      return (line[_index] != CHAR_EOS) ? line[_index] : CHAR_LF;
+    }
+
+    int read(void) override {
+      int c = peek();
+      if(c == CHAR_LF){
+        _line = (_line + 1) % LINES_COUNT;
+        _index = 0;
+      } else {
+        _index++;
+      }
+      return c;
+    }
+
+    size_t write(uint8_t c) override {
+      (void)c;
+      written++;
+      return 1;
+    }
+    using Print::write;
+
+    uint32_t written; // the number of bytes written (no command is expected)
+
+  private:
+    uint8_t _line;
+    uint8_t _index;
+};
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Match the tokens in a line (previous implementation)
+//  @param (line)   : the line [char *]
+//         (length) : the length of the line [uint16_t]
+//  @returns the tokens found [uint8_t]
+uint8_t match_memmem(const char *line, uint16_t length){
+  uint8_t data[64]; // (copy of the buffer, as the VLA of the previous implementation)
+  memcpy(data, line, length);
+  uint8_t tokens = 0;
+  for(uint8_t i=0 ; i < SMW_SX1276M0_TOKEN_COUNT ; i++){
+    if(memmem(data, length, TOKENS[i].data, TOKENS[i].length)){
+      tokens |= (1 << i);
+    }
+  }
+  return tokens;
+}
+
+// --------------------------------------------------
+
+// Build the automaton (the same states as <MATCHER>)
+//  NOTE: the next state is the longest prefix of a token that is a suffix of
+//        the current prefix followed by the byte (checked by brute force)
+void build_automaton(void){
+  std::string prefixes[STATES];
+  uint8_t state = 1;
+  for(uint8_t i=0 ; i < SMW_SX1276M0_TOKEN_COUNT ; i++){
+    for(uint8_t j=1 ; j <= TOKENS[i].length ; j++){
+      prefixes[state++].assign(reinterpret_cast<const char *>(TOKENS[i].data), j);
+    }
+  }
+
+  for(uint8_t s=0 ; s < STATES ; s++){
+    automaton_found[s] = 0;
+    for(uint8_t i=0 ; i < SMW_SX1276M0_TOKEN_COUNT ; i++){
+      const std::string token(reinterpret_cast<const char *>(TOKENS[i].data), TOKENS[i].length);
+      if((prefixes[s].size() >= token.size()) && (prefixes[s].compare(prefixes[s].size() - token.size(), token.size(), token) == 0)){
+        automaton_found[s] |= (1 << i);
+      }
+    }
+    for(uint16_t c=0 ; c < 256 ; c++){
+      std::string text = prefixes[s] + static_cast<char>(c);
+      uint8_t next = 0;
+      for(uint8_t t=1 ; t < STATES ; t++){
+        const std::string &prefix = prefixes[t];
+        if((prefix.size() <= text.size()) && (prefix.size() > prefixes[next].size()) &&
+            (text.compare(text.size() - prefix.size(), prefix.size(), prefix) == 0)){
+          next = t;
+        }
+      }
+      automaton_next[s][c] = next;
+    }
+  }
+}
+
+// --------------------------------------------------
+
+// Match the tokens in a line, one byte at a time (as <_match_tokens()>)
+//  @param (line)   : the line [char *]
+//         (length) : the length of the line [uint16_t]
+//  @returns the tokens found [uint8_t]
+uint8_t match_automaton(const char *line, uint16_t length){
+  uint8_t state = 0;
+  uint8_t tokens = 0;
+  for(uint16_t j=0 ; j < length ; j++){
+    state = automaton_next[state][static_cast<uint8_t>(line[j])];
+    tokens |= automaton_found[state];
+  }
+  return tokens;
+}
+
+// --------------------------------------------------
+
+// Match the tokens in a line, one byte at a time and one state per token (previous streaming implementation)
+//  @param (line)   : the line [char *]
+//         (length) : the length of the line [uint16_t]
+//  @returns the tokens found [uint8_t]
+//  NOTE: the restart on a mismatch is only correct for tokens without a prefix that is also a suffix
+uint8_t match_streaming(const char *line, uint16_t length){
+  uint8_t progress[SMW_SX1276M0_TOKEN_COUNT] = { 0 };
+  uint8_t tokens = 0;
+  for(uint16_t j=0 ; j < length ; j++){
+    uint8_t c = line[j];
+    for(uint8_t i=0 ; i < SMW_SX1276M0_TOKEN_COUNT ; i++){
+      if(tokens & (1 << i)){
+        continue;
+      }
+      const Token &token = TOKENS[i];
+      uint8_t p = progress[i];
+      if(c == token.data[p]){
+        p++;
+      } else {
+        p = (c == token.data[0]) ? 1 : 0;
+      }
+      if(p == token.length){
+        tokens |= (1 << i);
+        p = 0;
+      }
+      progress[i] = p;
+    }
+  }
+  return tokens;
+}
+
+// --------------------------------------------------
+
+// Measure the time to match a line
+//  @param (match) : the matcher [function]
+//  @returns the average time in nanoseconds [double]
+double measure_matcher(uint8_t (*match)(const char *, uint16_t)){
+  uint16_t lengths[LINES_COUNT];
+  for(uint8_t i=0 ; i < LINES_COUNT ; i++){
+    lengths[i] = strlen(LINES[i]);
+  }
+  volatile uint32_t sink = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(uint32_t k=0 ; k < ITERATIONS ; k++){
+    uint8_t i = k % LINES_COUNT;
+    sink += match(LINES[i], lengths[i]);
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+// --------------------------------------------------
+
+uint32_t events = 0;
+
+void event_handler(Event type){
+  (void)type;
+  events++;
+}
+
+// --------------------------------------------------
+
+int main(void){
+  printf("Matcher benchmark (%lu lines, average in ns per line)\n\n", static_cast<unsigned long>(ITERATIONS));
+  build_automaton();
+  for(uint8_t i=0 ; i < LINES_COUNT ; i++){
+    if(match_automaton(LINES[i], strlen(LINES[i])) != match_memmem(LINES[i], strlen(LINES[i]))){
+      printf("ERROR: the automaton doesn't match the line \"%s\"\n", LINES[i]);
+      return 1;
+    }
+  }
+  printf("  copy + memmem(): %6.0f\n", measure_matcher(match_memmem));
+  printf("  one per token:   %6.0f\n", measure_matcher(match_streaming));
+  printf("  automaton:       %6.0f\n", measure_matcher(match_automaton));
+
+  // parse the lines with the library
+  //  NOTE: with the virtual clock, so that the delay after each RECV event takes no time
+  host_clock_virtual(true);
+  LineModule module;
+  SMW_SX1276M0 lorawan(module);
+  lorawan.event_listener = event_handler;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(uint32_t k=0 ; k < ITERATIONS ; k++){
+    lorawan.listen(); // (one line)
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  printf("\n  listen(): %.0f lines/s (%lu events, %lu bytes written)\n", ITERATIONS / seconds,
+    static_cast<unsigned long>(events), static_cast<unsigned long>(module.written));
+
+  printf("\nNOTE: the automaton avoids the copy of the line with one step per byte (on the computer it is about as fast as memmem())\n");
+  return 0;
+}
+
+// --------------------------------------------------
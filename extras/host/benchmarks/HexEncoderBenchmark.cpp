@@ -0,0 +1,183 @@
+/*******************************************************************************
+* Benchmark of the hexadecimal encoder (v1.0)
+*
+* Compares the binary sendX(), which encodes the payload while it is sent,
+* with an hexadecimal string built before the call (snprintf("%02X") and
+* a lookup table), for payloads of 11 to 242 bytes.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <chrono>
+
+#include "RoboCore_SMW_SX1276M0.h"
+
+// --------------------------------------------------
+// Constants
+
+const uint8_t SIZES[] = { 11 , 51 , 115 , 242 };
+const uint32_t ITERATIONS = 20000;
+
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+const char REPLY[] = "<OK>\r\n";
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module that discards the commands and replies <OK> immediately
+class SinkModule : public Stream {
+  public:
+    SinkModule() : _index(0), _length(0) {}
+
+    int available(void) override {
+      return _length - _index;
+    }
+
+    int peek(void) override {
+      return (_index < _length) ? REPLY[_index] : -1;
+    }
+
+    int read(void) override {
+      int c = peek();
+      if(c >= 0){
+        _index++;
+      }
+      return c;
+    }
+
+    size_t write(uint8_t c) override {
+      if(c == CHAR_CR){
+        _index = 0;
+        _length = sizeof(REPLY) - 1;
+      }
+      return 1;
+    }
+    using Print::write;
+
+  private:
+    uint8_t _index;
+    uint8_t _length;
+};
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Encode with snprintf()
+//  @param (data)   : the data to encode [uint8_t *]
+//         (length) : the length of the data [uint8_t]
+//         (out)    : the string to store the encoded data [char *]
+void encode_snprintf(const uint8_t *data, uint8_t length, char *out){
+  for(uint8_t i=0 ; i < length ; i++){
+    snprintf(&out[2*i], 3, "%02X", data[i]);
+  }
+  out[2*length] = CHAR_EOS;
+}
+
+// --------------------------------------------------
+
+// Encode with a lookup table (as the library)
+//  @param (data)   : the data to encode [uint8_t *]
+//         (length) : the length of the data [uint8_t]
+//         (out)    : the string to store the encoded data [char *]
+void encode_table(const uint8_t *data, uint8_t length, char *out){
+  for(uint8_t i=0 ; i < length ; i++){
+    out[2*i] = HEX_DIGITS[data[i] >> 4];
+    out[2*i + 1] = HEX_DIGITS[data[i] & 0x0F];
+  }
+  out[2*length] = CHAR_EOS;
+}
+
+// --------------------------------------------------
+
+// Measure the time to encode a payload
+//  @param (encode) : the encoder [function]
+//         (data)   : the data to encode [uint8_t *]
+//         (length) : the length of the data [uint8_t]
+//  @returns the average time in nanoseconds [double]
+double measure_encoder(void (*encode)(const uint8_t *, uint8_t, char *), uint8_t *data, uint8_t length){
+  char out[2*255 + 1];
+  volatile uint32_t sink = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(uint32_t k=0 ; k < ITERATIONS ; k++){
+    data[k % length]++; // change the data
+    encode(data, length, out);
+    sink += out[k % (2*length)];
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+// --------------------------------------------------
+
+// Measure the time to send a payload (command and response)
+//  @param (lorawan) : the driver [SMW_SX1276M0 &]
+//         (data)    : the data to send [uint8_t *]
+//         (length)  : the length of the data [uint8_t]
+//         (binary)  : true to use the binary sendX(), false to encode to a string before [bool]
+//  @returns the average time in nanoseconds [double]
+double measure_send(SMW_SX1276M0 &lorawan, uint8_t *data, uint8_t length, bool binary){
+  char out[2*255 + 1];
+  uint32_t errors = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(uint32_t k=0 ; k < ITERATIONS ; k++){
+    data[k % length]++; // change the data
+    CommandResponse res;
+    if(binary){
+      res = lorawan.sendX(1, data, length);
+    } else {
+      encode_table(data, length, out);
+      res = lorawan.sendX(1, out);
+    }
+    if(res != CommandResponse::OK){
+      errors++;
+    }
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  if(errors > 0){
+    printf("  (%lu errors)\n", static_cast<unsigned long>(errors));
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+// --------------------------------------------------
+
+int main(void){
+  SinkModule module;
+  SMW_SX1276M0 lorawan(module);
+
+  uint8_t data[255];
+  for(uint16_t i=0 ; i < sizeof(data) ; i++){
+    data[i] = i * 13;
+  }
+
+  printf("Hexadecimal encoder benchmark (%lu iterations, average in ns)\n\n", static_cast<unsigned long>(ITERATIONS));
+  printf("  size | encoder: snprintf      table | sendX(): string     binary | RAM: string  binary\n");
+  for(uint8_t size : SIZES){
+    printf("  %4u | %17.0f %10.0f | %15.0f %10.0f | %11u %7u\n", size,
+      measure_encoder(encode_snprintf, data, size), measure_encoder(encode_table, data, size),
+      measure_send(lorawan, data, size, false), measure_send(lorawan, data, size, true),
+      size + (2*size + 1), size); // (the binary data and the string)
+  }
+  return 0;
+}
+
+// --------------------------------------------------
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* SMW_SX1276M0 Emulator Send and Receive (v1.0)
+*
+* Program to run the library on a computer (Linux) with the emulator of the
+* module: reset, join (OTAA), send a message and receive a downlink.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "SMW_SX1276M0_Emulator.h"
+
+// --------------------------------------------------
+// Variables
+
+SMW_SX1276M0_Emulator module;
+SMW_SX1276M0 lorawan(module);
+
+const uint8_t PIN_RESET = 4;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Print the downlinks
+void downlink_handler(Downlink &downlink){
+  printf("Downlink on port %d: %.*s\n", downlink.port, downlink.payload.length, reinterpret_cast<const char *>(downlink.payload.data));
+}
+
+// --------------------------------------------------
+
+int main(void){
+  lorawan.setPinReset(PIN_RESET);
+  module.attachResetPin(PIN_RESET);
+  module.setJoinTime(2000);
+  lorawan.setPortHandler(10, downlink_handler);
+
+  // reset the module
+  CommandResponse response = lorawan.reset();
+  printf("Reset: %s (%lu ms)\n", (response == CommandResponse::OK) ? "OK" : "error", static_cast<unsigned long>(lorawan.get_BootTime()));
+
+  // join the network
+  lorawan.set_JoinMode(SMW_SX1276M0_JOIN_MODE_OTAA);
+  lorawan.set_AppEUI("0000000000000000");
+  lorawan.set_AppKey("00000000000000000000000000000000");
+  lorawan.join_async();
+  while(lorawan.get_JoinState() == JoinState::JOINING){
+    lorawan.poll();
+  }
+  printf("Joined: %s (%d attempt(s))\n", lorawan.isConnected() ? "yes" : "no", lorawan.get_JoinAttempts());
+
+  // send a message (the downlink is received after it)
+  module.downlinkT(10, "hello");
+  uint32_t start = millis();
+  response = lorawan.sendT(1, "ping");
+  printf("Uplink: %s (%lu ms)\n", (response == CommandResponse::OK) ? "OK" : "error", static_cast<unsigned long>(millis() - start));
+
+  // receive the downlink
+  uint32_t timeout = millis() + SMW_SX1276M0_EMULATOR_UPLINK + 100; // (after the receive windows)
+  while(millis() < timeout){
+    lorawan.listen_all();
+  }
+
+  printf("Commands: %lu\n", static_cast<unsigned long>(module.getCommandCount()));
+  return 0;
+}
+
+// --------------------------------------------------
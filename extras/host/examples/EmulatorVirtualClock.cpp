@@ -0,0 +1,104 @@
+/*******************************************************************************
+* SMW_SX1276M0 Emulator Virtual Clock (v1.0)
+*
+* Program to run many exchanges with the emulator of the module on the
+* virtual clock, which makes the waits instantaneous and the times
+* reproducible.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <chrono>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "SMW_SX1276M0_Emulator.h"
+
+// --------------------------------------------------
+// Variables
+
+SMW_SX1276M0_Emulator module;
+SMW_SX1276M0 lorawan(module);
+
+const uint16_t EXCHANGES = 10000;
+
+uint16_t joined = 0;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Count the JOINED events
+void event_handler(Event type){
+  if(type == Event::JOINED){
+    joined++;
+  }
+}
+
+// --------------------------------------------------
+
+// Send a JOINED event (called by the virtual clock)
+void send_joined(void *context){
+  static_cast<SMW_SX1276M0_Emulator *>(context)->emit("[EVENT] JOINED");
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  lorawan.event_listener = event_handler;
+  module.setLatency(CMD_AT, 3);
+  module.setLatency(CMD_DR, 15);
+
+  // reset the module (5 s of timeout)
+  CommandResponse response = lorawan.reset();
+  printf("Reset: %s (%lu ms)\n", (response == CommandResponse::OK) ? "OK" : "error", static_cast<unsigned long>(lorawan.get_BootTime()));
+
+  // exchange commands
+  uint32_t total = 0;
+  uint16_t errors = 0;
+  for(uint16_t i=0 ; i < EXCHANGES ; i++){
+    uint8_t dr;
+    response = (i % 2) ? lorawan.get_DR(dr) : lorawan.ping();
+    if(response == CommandResponse::OK){
+      total += lorawan.get_ResponseTime();
+    } else {
+      errors++;
+    }
+  }
+  printf("Exchanges: %u (%u errors), %lu ms of response on average\n", EXCHANGES, errors, static_cast<unsigned long>(total / EXCHANGES));
+
+  // receive an event at an exact time
+  uint32_t time = millis() + 60000; // 1 min
+  host_clock_at(time, send_joined, &module);
+  while(joined == 0){
+    lorawan.listen_all();
+  }
+  printf("Event: %lu ms late\n", static_cast<unsigned long>(lorawan.get_EventTime() - time));
+
+  // compare the times
+  uint32_t real = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  printf("Virtual time: %lu ms, real time: %lu ms\n", static_cast<unsigned long>(millis()), static_cast<unsigned long>(real));
+  return 0;
+}
+
+// --------------------------------------------------
@@ -0,0 +1,79 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+/*******************************************************************************
+* RoboCore Host Test (v1.0)
+*
+* Minimal checks for the tests of the library on a computer (Linux).
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+#include <stdio.h>
+
+// --------------------------------------------------
+// Macros
+
+// Check a condition (the test continues if it fails)
+#define TEST_CHECK(condition) host_test_check((condition), #condition, __FILE__, __LINE__)
+
+// --------------------------------------------------
+// Variables
+
+static unsigned int host_test_count = 0;
+static unsigned int host_test_failures = 0;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Check a condition
+//  @param (condition) : the result of the condition [bool]
+//         (text)      : the text of the condition [char *]
+//         (file)      : the source file [char *]
+//         (line)      : the line in the source file [int]
+//  @returns the result of the condition [bool]
+static inline bool host_test_check(bool condition, const char *text, const char *file, int line){
+  host_test_count++;
+  if(!condition){
+    host_test_failures++;
+    printf("%s:%d: check failed: %s\n", file, line, text);
+  }
+  return condition;
+}
+
+// --------------------------------------------------
+
+// Print the result of the test
+//  @param (name) : the name of the test [char *]
+//  @returns the exit code of the program (0 if all the checks passed) [int]
+static inline int host_test_end(const char *name){
+  if(host_test_failures > 0){
+    printf("%s: FAILED (%u of %u checks)\n", name, host_test_failures, host_test_count);
+    return 1;
+  }
+  printf("%s: OK (%u checks)\n", name, host_test_count);
+  return 0;
+}
+
+// --------------------------------------------------
+
+#endif // HOST_TEST_H
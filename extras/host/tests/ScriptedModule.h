@@ -0,0 +1,141 @@
+#ifndef SCRIPTED_MODULE_H
+#define SCRIPTED_MODULE_H
+
+/*******************************************************************************
+* RoboCore Scripted Module (v1.0)
+*
+* Stream with replies written by each test, for the cases that the emulator
+* of the module doesn't produce (lines in the middle of a response, modules
+* that don't reply, ...).
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// NOTE: override <handle()> to reply to the commands (the default replies <OK>)
+// NOTE: the times are given by the virtual clock (see <host_clock_virtual()>)
+class ScriptedModule : public Stream {
+  public:
+    std::vector<std::string> commands; // the commands received (without the CR)
+
+    virtual ~ScriptedModule() {}
+
+    // Stream
+    int available(void) override {
+      int count = 0;
+      for(const Chunk &chunk : _chunks){
+        if(chunk.time > host_clock_millis()){
+          break;
+        }
+        count += chunk.data.size();
+      }
+      if(count == 0){
+        host_clock_poll();
+      }
+      return count;
+    }
+
+    int peek(void) override {
+      if((_chunks.empty()) || (_chunks.front().time > host_clock_millis())){
+        return -1;
+      }
+      return static_cast<uint8_t>(_chunks.front().data[0]);
+    }
+
+    int read(void) override {
+      int c = peek();
+      if(c >= 0){
+        _chunks.front().data.erase(0, 1);
+        if(_chunks.front().data.empty()){
+          _chunks.pop_front();
+        }
+        host_clock_activity();
+      }
+      return c;
+    }
+
+    size_t write(uint8_t c) override {
+      host_clock_activity();
+      if(c == '\r'){
+        commands.push_back(_line);
+        std::string line = _line;
+        _line.clear();
+        handle(line);
+      } else {
+        _line += static_cast<char>(c);
+      }
+      return 1;
+    }
+    using Print::write;
+
+    // Reply to a command
+    //  @param (line) : the command received (without the CR) [std::string]
+    virtual void handle(const std::string &line){
+      (void)line;
+      reply("<OK>\r\n");
+    }
+
+    // Send data to the library
+    //  @param (data)  : the data to send [std::string]
+    //         (delay) : the time to wait before sending [ms] [uint32_t] (default: 2)
+    void reply(const std::string &data, uint32_t delay = 2){
+      uint32_t time = host_clock_millis() + delay;
+      if(!_chunks.empty() && (_chunks.back().time > time)){
+        time = _chunks.back().time; // keep the order
+      }
+      _chunks.push_back({ time , data });
+    }
+
+    // Count the commands received that start with a text
+    //  @param (start) : the start of the command [std::string]
+    //  @returns the number of commands [size_t]
+    size_t count(const std::string &start) const {
+      size_t res = 0;
+      for(const std::string &command : commands){
+        if(command.compare(0, start.size(), start) == 0){
+          res++;
+        }
+      }
+      return res;
+    }
+
+  private:
+    struct Chunk {
+      uint32_t time; // [ms]
+      std::string data;
+    };
+
+    std::deque<Chunk> _chunks;
+    std::string _line;
+};
+
+// --------------------------------------------------
+
+#endif // SCRIPTED_MODULE_H
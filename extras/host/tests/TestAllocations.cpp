@@ -0,0 +1,213 @@
+/*******************************************************************************
+* Test of the heap allocations (v1.0)
+*
+* Counts the heap allocations (operator new) of the driver: there must be
+* none in the constructor and in the steady state (commands, events,
+* downlinks and queued commands).
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <new>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+
+// --------------------------------------------------
+// Variables
+
+static uint32_t allocations = 0;
+static bool counting = false;
+
+// --------------------------------------------------
+// Operators (count the allocations)
+
+void* operator new(size_t size){
+  if(counting){
+    allocations++;
+  }
+  void *p = malloc(size ? size : 1);
+  if(!p){
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](size_t size){
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+  free(p);
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module without heap allocations (fixed arrays), with immediate replies
+class FixedModule : public Stream {
+  public:
+    FixedModule() : _head(0), _count(0), _length(0) {}
+
+    int available(void) override {
+      if(_count == 0){
+        host_clock_poll();
+      }
+      return _count;
+    }
+
+    int peek(void) override {
+      return (_count > 0) ? _data[_head] : -1;
+    }
+
+    int read(void) override {
+      int c = peek();
+      if(c >= 0){
+        _head = (_head + 1) % sizeof(_data);
+        _count--;
+        host_clock_activity();
+      }
+      return c;
+    }
+
+    size_t write(uint8_t c) override {
+      host_clock_activity();
+      if(c == CHAR_CR){
+        _line[_length] = CHAR_EOS;
+        _length = 0;
+        if(strcmp(_line, "AT+DR") == 0){
+          emit("3\r\n<OK>\r\n");
+        } else if(strcmp(_line, "AT+RECV") == 0){
+          emit("2:hello\r\n<OK>\r\n");
+        } else {
+          emit("<OK>\r\n");
+        }
+      } else if(_length < (sizeof(_line) - 1)){
+        _line[_length++] = c;
+      }
+      return 1;
+    }
+    using Print::write;
+
+    // Send data to the library
+    //  @param (data) : the data to send [char *]
+    void emit(const char *data){
+      for( ; *data && (_count < sizeof(_data)) ; data++){
+        _data[(_head + _count) % sizeof(_data)] = *data;
+        _count++;
+      }
+    }
+
+  private:
+    uint8_t _data[256];
+    uint16_t _head;
+    uint16_t _count;
+    char _line[128];
+    uint8_t _length;
+};
+
+// --------------------------------------------------
+
+uint8_t events = 0;
+
+void event_handler(Event type){
+  (void)type;
+  events++;
+}
+
+// --------------------------------------------------
+
+void queue_handler(CommandResult &result){
+  (void)result;
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  FixedModule module;
+
+  // constructor
+  counting = true;
+  SMW_SX1276M0 *lorawan = new SMW_SX1276M0(module); // (the object itself)
+  counting = false;
+  TEST_CHECK(allocations == 1);
+  lorawan->event_listener = event_handler;
+
+  // steady state
+  allocations = 0;
+  for(uint16_t i=0 ; i < 100 ; i++){
+    counting = true;
+    uint8_t value = 0;
+    bool ok = (lorawan->get_DR(value) == CommandResponse::OK) && (value == 3);
+    ok = ok && (lorawan->set_ADR(SMW_SX1276M0_ADR_ON) == CommandResponse::OK);
+    ok = ok && (lorawan->ping() == CommandResponse::OK);
+    ok = ok && (lorawan->sendT(1, "hello") == CommandResponse::OK);
+
+    module.emit("[EVENT] JOINED\r\n");
+    lorawan->listen_all();
+
+    StaticBuffer<20> data;
+    uint8_t port = 0;
+    ok = ok && (lorawan->readT(port, data) == CommandResponse::OK) && (port == 2) && (data.available() == 5);
+
+    ok = ok && lorawan->enqueue_get(CMD_DR, queue_handler);
+    while(lorawan->get_QueueCount() > 0 || lorawan->isBusy()){
+      lorawan->poll();
+    }
+    counting = false;
+    if(!TEST_CHECK(ok)){
+      break;
+    }
+  }
+  TEST_CHECK(events == 100);
+  TEST_CHECK(allocations == 0);
+  printf("Allocations in the steady state: %lu\n", static_cast<unsigned long>(allocations));
+
+  delete lorawan;
+
+  // the static buffers can be copied to and from the others
+  StaticBuffer<4> a;
+  a.append(1);
+  StaticBuffer<4> b(a);
+  TEST_CHECK((b.available() == 1) && (b[0] == 1));
+  Buffer h(3);
+  h = a;
+  TEST_CHECK((h.available() == 1) && (h[0] == 1));
+
+  return host_test_end("allocations");
+}
+
+// --------------------------------------------------
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Test of the Buffer (v1.0)
+*
+* Checks the circular Buffer (wrap around, resize, copy) and the count of
+* the bytes discarded (overflow), which saturates.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "Buffer.h"
+#include "HostTest.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+int main(void){
+  // wrap around
+  Buffer buffer(5);
+  for(uint8_t i=0 ; i < 3 ; i++){
+    buffer.append(i);
+  }
+  buffer.read();
+  buffer.read();
+  for(uint8_t i=3 ; i < 7 ; i++){
+    buffer.append(i);
+  }
+  TEST_CHECK(buffer.isFull());
+  uint8_t data[5];
+  buffer.copy(data);
+  for(uint8_t i=0 ; i < 5 ; i++){
+    TEST_CHECK((data[i] == (i + 2)) && (buffer[i] == (i + 2)));
+  }
+
+  // resize (the data is kept in order)
+  buffer.resize(10);
+  for(uint8_t i=0 ; i < 5 ; i++){
+    TEST_CHECK(buffer[i] == (i + 2));
+  }
+  buffer.append(9);
+  TEST_CHECK((buffer.available() == 6) && (buffer[5] == 9));
+
+  // overflow
+  StaticBuffer<4> small;
+  for(uint8_t i=0 ; i < 10 ; i++){
+    small.append(i);
+  }
+  TEST_CHECK((small.available() == 4) && (small.overflow() == 6));
+  small.reset();
+  TEST_CHECK(small.overflow() == 0);
+
+  // overflow saturated (appending and copying into a smaller buffer)
+  StaticBuffer<1> tiny;
+  for(uint32_t i=0 ; i < 70000 ; i++){
+    tiny.append(i);
+  }
+  TEST_CHECK(tiny.overflow() == UINT16_MAX);
+  Buffer large(600);
+  for(uint16_t i=0 ; i < 600 ; i++){
+    large.append(i);
+  }
+  tiny = large;
+  TEST_CHECK((tiny.available() == 1) && (tiny.overflow() == 599));
+  for(uint32_t i=0 ; i < 65000 ; i++){
+    large.append(i);
+  }
+  TEST_CHECK(large.overflow() == 65000);
+  tiny = large;
+  TEST_CHECK(tiny.overflow() == UINT16_MAX);
+
+  return host_test_end("buffer");
+}
+
+// --------------------------------------------------
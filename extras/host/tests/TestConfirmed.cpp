@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Test of the confirmed messages (v1.0)
+*
+* Checks that the tracker of confirmed messages refuses the messages while
+* the uplink confirmation is off (read from the module if unknown), counts
+* an OK as an acknowledgement only with the confirmation on and retries the
+* failed sends with a backoff.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module with the uplink confirmation off (by default) that fails the first sends
+class ConfirmModule : public ScriptedModule {
+  public:
+    uint8_t failures = 0; // the number of sends to fail
+
+    void handle(const std::string &line) override {
+      if(line == "AT+CFM"){
+        reply("0\r\n<OK>\r\n");
+      } else if(line.compare(0, 7, "AT+SEND") == 0){
+        if(failures > 0){
+          failures--;
+          reply("<Failed>\r\n", 50);
+        } else {
+          reply("<OK>\r\n", 50);
+        }
+      } else {
+        ScriptedModule::handle(line);
+      }
+    }
+};
+
+// --------------------------------------------------
+
+// Poll the driver until the tracker is empty
+//  @param (lorawan) : the driver [SMW_SX1276M0 &]
+void run(SMW_SX1276M0 &lorawan){
+  uint32_t start = millis();
+  while((lorawan.get_ConfirmedCount(ConfirmedState::PENDING) > 0) && ((millis() - start) < 600000)){
+    lorawan.poll();
+    delay(10);
+  }
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  ConfirmModule module;
+  SMW_SX1276M0 lorawan(module);
+  lorawan.setDutyCycle(false);
+
+  // the confirmation is read and is off
+  TEST_CHECK(!lorawan.confirm_sendT(1, "hello"));
+  TEST_CHECK(module.count("AT+CFM") == 1);
+  TEST_CHECK(!lorawan.confirm_sendT(1, "hello")); // (from the shadow)
+  TEST_CHECK(module.count("AT+CFM") == 1);
+
+  // acknowledged after two retries
+  TEST_CHECK(lorawan.set_Confirmation(1) == CommandResponse::OK);
+  module.failures = 2;
+  TEST_CHECK(lorawan.confirm_sendT(1, "hello"));
+  run(lorawan);
+  ConfirmedReport report;
+  lorawan.get_ConfirmedReport(report);
+  TEST_CHECK((report.state == ConfirmedState::ACKED) && (report.attempts == 3));
+  TEST_CHECK(report.latency >= (SMW_SX1276M0_CONFIRMED_BACKOFF_MIN / 2) + SMW_SX1276M0_CONFIRMED_BACKOFF_MIN); // (two backoffs of at least half)
+  TEST_CHECK(lorawan.get_ConfirmedCount(ConfirmedState::ACKED) == 1);
+
+  // the confirmation is turned off after the message was added
+  TEST_CHECK(lorawan.confirm_sendX(2, "0102"));
+  TEST_CHECK(lorawan.set_Confirmation(0) == CommandResponse::OK);
+  run(lorawan);
+  lorawan.get_ConfirmedReport(report);
+  TEST_CHECK((report.state == ConfirmedState::FAILED) && (report.port == 2));
+  TEST_CHECK(lorawan.get_ConfirmedCount(ConfirmedState::ACKED) == 1);
+  TEST_CHECK(lorawan.get_ConfirmedCount(ConfirmedState::FAILED) == 1);
+
+  return host_test_end("confirmed");
+}
+
+// --------------------------------------------------
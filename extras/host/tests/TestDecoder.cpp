@@ -0,0 +1,107 @@
+/*******************************************************************************
+* Test of the hexadecimal decoder (v1.0)
+*
+* Checks that readX() decodes only the response to its own command, even
+* when another command is still pending, and that the malformed payloads
+* give an error.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module with a slow DevEUI (with colons, as the payloads) and a given downlink
+class DownlinkModule : public ScriptedModule {
+  public:
+    std::string downlink = "5:0A0B0C";
+
+    void handle(const std::string &line) override {
+      if(line == "AT+DEVEUI"){
+        reply("00:11:22:33:44:55:66:77\r\n<OK>\r\n", 10);
+      } else if(line == "AT+RECVB"){
+        reply(downlink + "\r\n<OK>\r\n");
+      } else {
+        reply("<OK>\r\n");
+      }
+    }
+};
+
+// --------------------------------------------------
+
+std::string deveui;
+
+void queue_handler(CommandResult &result){
+  while(result.data && result.data->available()){
+    deveui += static_cast<char>(result.data->read());
+  }
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  DownlinkModule module;
+  SMW_SX1276M0 lorawan(module);
+
+  uint8_t data[8];
+  uint8_t port = 0;
+  uint16_t length = 0;
+
+  // the pending command is not decoded
+  TEST_CHECK(lorawan.enqueue_get(CMD_DEVEUI, queue_handler));
+  lorawan.poll(); // (send the command)
+  TEST_CHECK(lorawan.isBusy());
+  TEST_CHECK(lorawan.readX(port, data, sizeof(data), length) == CommandResponse::OK);
+  TEST_CHECK((port == 5) && (length == 3));
+  TEST_CHECK((data[0] == 0x0A) && (data[1] == 0x0B) && (data[2] == 0x0C));
+  TEST_CHECK(deveui == "00:11:22:33:44:55:66:77");
+
+  // the next commands are not decoded
+  memset(data, 0, sizeof(data));
+  deveui.clear();
+  TEST_CHECK(lorawan.enqueue_get(CMD_DEVEUI, queue_handler));
+  while((lorawan.get_QueueCount() > 0) || lorawan.isBusy()){
+    lorawan.poll();
+  }
+  TEST_CHECK(deveui == "00:11:22:33:44:55:66:77");
+  TEST_CHECK(data[0] == 0);
+
+  // malformed payloads
+  module.downlink = "5:0A0";
+  TEST_CHECK(lorawan.readX(port, data, sizeof(data), length) == CommandResponse::ERROR);
+  module.downlink = "5:0G";
+  TEST_CHECK(lorawan.readX(port, data, sizeof(data), length) == CommandResponse::ERROR);
+  module.downlink = "5:";
+  TEST_CHECK(lorawan.readX(port, data, sizeof(data), length) == CommandResponse::OK);
+  TEST_CHECK((port == 5) && (length == 0));
+  TEST_CHECK(lorawan.ping() == CommandResponse::OK);
+
+  return host_test_end("decoder");
+}
+
+// --------------------------------------------------
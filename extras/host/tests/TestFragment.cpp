@@ -0,0 +1,136 @@
+/*******************************************************************************
+* Test of the fragmented messages (v1.0)
+*
+* Checks sendFragmented() and the reassembler: the size of the fragments for
+* the data rate, the reassembly out of order, the empty message and the
+* message too long.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <vector>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module in EU868 that stores the frames sent
+class FrameModule : public ScriptedModule {
+  public:
+    std::vector<std::vector<uint8_t>> frames;
+    std::string dr = "0";
+
+    void handle(const std::string &line) override {
+      if(line.compare(0, 9, "AT+SENDB ") == 0){
+        std::string hex = line.substr(line.find(':') + 1);
+        std::vector<uint8_t> frame;
+        for(size_t i=0 ; i < hex.size() ; i += 2){
+          frame.push_back(strtoul(hex.substr(i, 2).c_str(), nullptr, 16));
+        }
+        frames.push_back(frame);
+        reply("<OK>\r\n");
+      } else if(line == "AT+REGION"){
+        reply("5\r\n<OK>\r\n");
+      } else if(line == "AT+DR"){
+        reply(dr + "\r\n<OK>\r\n");
+      } else if(line == "AT+ADR"){
+        reply("0\r\n<OK>\r\n");
+      } else {
+        ScriptedModule::handle(line);
+      }
+    }
+};
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  FrameModule module;
+  SMW_SX1276M0 lorawan(module);
+  std::vector<uint8_t> message(700);
+  for(size_t i=0 ; i < message.size() ; i++){
+    message[i] = i * 7 + 3;
+  }
+  uint8_t adr;
+  lorawan.get_ADR(adr); // (the data rate is kept after the uplinks)
+
+  // DR0 (51 bytes): 15 fragments, with the duty cycle
+  uint32_t start = millis();
+  TEST_CHECK(lorawan.sendFragmented(10, message.data(), message.size()) == CommandResponse::OK);
+  printf("700 bytes at EU868 DR0: %u fragments in %lu s\n", static_cast<unsigned>(module.frames.size()), static_cast<unsigned long>((millis() - start) / 1000));
+  TEST_CHECK(module.frames.size() == 15);
+  for(const std::vector<uint8_t> &frame : module.frames){
+    TEST_CHECK((frame.size() <= 51) && (frame[0] == 0) && (frame[2] == 15));
+  }
+
+  // reassembly (out of order, except the last)
+  SMW_SX1276M0_StaticReassembler<1024> reassembler;
+  if(module.frames.size() == 15){
+    for(int8_t i=13 ; i >= 0 ; i--){
+      TEST_CHECK(reassembler.add(module.frames[i].data(), module.frames[i].size()) == SMW_SX1276M0_FRAGMENT_INCOMPLETE);
+    }
+    TEST_CHECK(reassembler.missing() == 1);
+    TEST_CHECK(reassembler.add(module.frames[14].data(), module.frames[14].size()) == SMW_SX1276M0_FRAGMENT_COMPLETE);
+    TEST_CHECK((reassembler.length() == 700) && (memcmp(reassembler.data(), message.data(), 700) == 0));
+  }
+
+  // DR5 (242 bytes): 3 fragments, next ID
+  module.frames.clear();
+  module.dr = "5";
+  lorawan.invalidateShadow();
+  lorawan.get_ADR(adr);
+  lorawan.setDutyCycle(false);
+  TEST_CHECK(lorawan.sendFragmented(10, message.data(), message.size()) == CommandResponse::OK);
+  TEST_CHECK((module.frames.size() == 3) && (module.frames[0][0] == 1));
+  uint8_t status = SMW_SX1276M0_FRAGMENT_INCOMPLETE;
+  for(const std::vector<uint8_t> &frame : module.frames){
+    status = reassembler.add(frame.data(), frame.size());
+  }
+  TEST_CHECK(status == SMW_SX1276M0_FRAGMENT_COMPLETE);
+  TEST_CHECK((reassembler.length() == 700) && (memcmp(reassembler.data(), message.data(), 700) == 0));
+
+  // empty message
+  module.frames.clear();
+  TEST_CHECK(lorawan.sendFragmented(10, nullptr, 0) == CommandResponse::OK);
+  TEST_CHECK((module.frames.size() == 1) && (module.frames[0].size() == 3));
+  if(module.frames.size() == 1){
+    TEST_CHECK(reassembler.add(module.frames[0].data(), 3) == SMW_SX1276M0_FRAGMENT_COMPLETE);
+    TEST_CHECK(reassembler.length() == 0);
+  }
+
+  // too long (more than 255 fragments)
+  module.frames.clear();
+  module.dr = "0";
+  lorawan.invalidateShadow();
+  lorawan.get_ADR(adr);
+  std::vector<uint8_t> big(48 * 256);
+  TEST_CHECK(lorawan.sendFragmented(10, big.data(), big.size()) == CommandResponse::TOO_LONG);
+  TEST_CHECK(module.frames.empty());
+
+  return host_test_end("fragment");
+}
+
+// --------------------------------------------------
@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Test of the join manager (v1.0)
+*
+* Checks the non-blocking OTAA join (join_async()) with the emulator: the
+* retries with backoff, the confirmation by the join status and the
+* deadline.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "SMW_SX1276M0_Emulator.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Variables
+
+uint16_t joined = 0;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+void event_handler(Event type){
+  if(type == Event::JOINED){
+    joined++;
+  }
+}
+
+// --------------------------------------------------
+
+// Module that accepts the join on an attempt, without the JOINED event
+class SilentJoinModule : public ScriptedModule {
+  public:
+    uint8_t accept_on = 2;
+    uint8_t requests = 0;
+
+    void handle(const std::string &line) override {
+      if(line == "AT+JOIN"){
+        requests++;
+        reply("<OK>\r\n");
+      } else if(line == "AT+NJS"){
+        reply((requests >= accept_on) ? "1\r\n<OK>\r\n" : "0\r\n<OK>\r\n");
+      } else {
+        ScriptedModule::handle(line);
+      }
+    }
+};
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+  randomSeed(1);
+
+  // accepted on the third attempt
+  {
+    SMW_SX1276M0_Emulator module;
+    SMW_SX1276M0 lorawan(module);
+    lorawan.event_listener = event_handler;
+    module.setJoinAccept(false);
+
+    TEST_CHECK(lorawan.join_async());
+    TEST_CHECK(!lorawan.join_async()); // (already joining)
+    while(lorawan.get_JoinState() == JoinState::JOINING){
+      if(lorawan.get_JoinAttempts() == 2){ // (the second request was already ignored)
+        module.setJoinAccept(true);
+      }
+      lorawan.poll();
+    }
+    TEST_CHECK(lorawan.get_JoinState() == JoinState::JOINED);
+    TEST_CHECK(lorawan.get_JoinAttempts() == 3);
+    TEST_CHECK(joined == 1);
+    TEST_CHECK(lorawan.isConnected());
+    TEST_CHECK(millis() >= SMW_SX1276M0_JOIN_BACKOFF_MIN); // (two backoffs of at least half of the minimum)
+
+    // a reset of the module ends the join
+    module.reset();
+    uint32_t timeout = millis() + SMW_SX1276M0_EMULATOR_BOOT;
+    while(millis() < timeout){
+      lorawan.poll();
+    }
+    TEST_CHECK(lorawan.get_JoinState() == JoinState::IDLE);
+    TEST_CHECK(!lorawan.isConnected());
+  }
+
+  // accepted without the JOINED event (confirmed by the join status)
+  {
+    SilentJoinModule module;
+    SMW_SX1276M0 lorawan(module);
+    joined = 0;
+    lorawan.event_listener = event_handler;
+
+    lorawan.join_async();
+    while(lorawan.get_JoinState() == JoinState::JOINING){
+      lorawan.poll();
+    }
+    TEST_CHECK(lorawan.get_JoinState() == JoinState::JOINED);
+    TEST_CHECK(lorawan.get_JoinAttempts() == 2);
+    TEST_CHECK(joined == 1);
+  }
+
+  // never accepted
+  {
+    SMW_SX1276M0_Emulator module;
+    SMW_SX1276M0 lorawan(module);
+    module.setJoinAccept(false);
+
+    uint32_t start = millis();
+    lorawan.join_async(120000);
+    while(lorawan.get_JoinState() == JoinState::JOINING){
+      lorawan.poll();
+    }
+    TEST_CHECK(lorawan.get_JoinState() == JoinState::FAILED);
+    TEST_CHECK((millis() - start) >= 120000);
+    TEST_CHECK((millis() - start) < (120000 + SMW_SX1276M0_TIMEOUT_JOIN_ATTEMPT));
+    TEST_CHECK(!module.isJoined());
+  }
+
+  return host_test_end("join");
+}
+
+// --------------------------------------------------
@@ -0,0 +1,79 @@
+/*******************************************************************************
+* Test of listen_all() (v1.0)
+*
+* Checks that all the complete lines received are handled in a single call,
+* without waiting, and that a partial line is kept for the next call.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <vector>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Variables
+
+std::vector<Event> events;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+void event_handler(Event type){
+  events.push_back(type);
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  ScriptedModule module;
+  SMW_SX1276M0 lorawan(module);
+  lorawan.event_listener = event_handler;
+
+  // four complete lines and a partial one
+  module.reply("\x07*SMW\r\n[EVENT] SLEEP\r\n\x07*SMW\r\n[EVENT] RECV 3:hi\r\n[EVENT] JOI", 0);
+  uint32_t start = millis();
+  TEST_CHECK(lorawan.listen_all() == 4);
+  TEST_CHECK((millis() - start) <= 20); // (only the delay of the RECV event)
+  TEST_CHECK(events.size() == 4);
+  if(events.size() == 4){
+    TEST_CHECK(events[0] == Event::RESET);
+    TEST_CHECK(events[1] == Event::SLEEP);
+    TEST_CHECK(events[2] == Event::WAKEUP);
+    TEST_CHECK(events[3] == Event::RECEIVED);
+  }
+
+  // nothing more until the end of the line
+  TEST_CHECK(lorawan.listen_all() == 0);
+  module.reply("NED\r\n", 0);
+  TEST_CHECK(lorawan.listen_all() == 1);
+  TEST_CHECK(!events.empty() && (events.back() == Event::JOINED));
+  TEST_CHECK(lorawan.isConnected());
+
+  return host_test_end("listen_all");
+}
+
+// --------------------------------------------------
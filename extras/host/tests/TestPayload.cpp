@@ -0,0 +1,132 @@
+/*******************************************************************************
+* Test of the maximum payload (v1.0)
+*
+* Checks that the uplinks longer than the maximum payload of the region and
+* data rate are refused before being sent (TOO_LONG), on every send path.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "SMW_SX1276M0_Emulator.h"
+#include "HostTest.h"
+
+// --------------------------------------------------
+
+static_assert(max_payload(SMW_SX1276M0_REGION_US915, 3) == 242, "wrong maximum payload");
+static_assert(max_payload(SMW_SX1276M0_REGION_EU868, 0) == 51, "wrong maximum payload");
+static_assert(max_payload(SMW_SX1276M0_REGION_US915, 5) == 0, "wrong maximum payload");
+static_assert(max_payload(SMW_SX1276M0_REGION_KR920, 6) == 0, "wrong maximum payload");
+static_assert(max_payload(SMW_SX1276M0_REGION_EU868, 7) == 222, "wrong maximum payload"); // (FSK)
+
+// --------------------------------------------------
+// Variables
+
+CommandResponse queued = CommandResponse::ERROR;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+void queue_handler(CommandResult &result){
+  queued = result.response;
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  SMW_SX1276M0_Emulator module;
+  SMW_SX1276M0 lorawan(module);
+  lorawan.setDutyCycle(false);
+  TEST_CHECK(lorawan.set_JoinMode(SMW_SX1276M0_JOIN_MODE_P2P) == CommandResponse::OK); // (no join needed)
+  TEST_CHECK(lorawan.set_Region(SMW_SX1276M0_REGION_US915) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_ADR(SMW_SX1276M0_ADR_OFF) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(0) == CommandResponse::OK);
+  TEST_CHECK(lorawan.max_payload() == 11);
+
+  // synchronous sends
+  uint32_t uplinks = module.getUplinkCount();
+  TEST_CHECK(lorawan.sendT(1, "0123456789AB") == CommandResponse::TOO_LONG);
+  TEST_CHECK(lorawan.sendX(1, "001122334455667788990011") == CommandResponse::TOO_LONG);
+  uint8_t data[12] = { 0 };
+  TEST_CHECK(lorawan.sendX(1, data, 12) == CommandResponse::TOO_LONG);
+  TEST_CHECK(module.getUplinkCount() == uplinks); // (nothing sent)
+  TEST_CHECK(lorawan.sendX(1, data, 11) == CommandResponse::OK);
+  TEST_CHECK(lorawan.sendT(1, "0123456789A") == CommandResponse::OK);
+  TEST_CHECK(module.getUplinkCount() == (uplinks + 2));
+
+  // asynchronous and queued sends
+  TEST_CHECK(lorawan.sendT_async(1, "0123456789AB") == CommandResponse::TOO_LONG);
+  TEST_CHECK(lorawan.enqueue_sendT(1, "0123456789AB", queue_handler));
+  while(lorawan.get_QueueCount() > 0){
+    lorawan.poll();
+  }
+  TEST_CHECK(queued == CommandResponse::TOO_LONG);
+  TEST_CHECK(module.getUplinkCount() == (uplinks + 2));
+
+  // other data rate
+  TEST_CHECK(lorawan.set_DR(3) == CommandResponse::OK);
+  TEST_CHECK(lorawan.max_payload() == 242);
+  TEST_CHECK(lorawan.sendT(1, "0123456789AB") == CommandResponse::OK);
+
+  // with the ADR, the data rate of the last uplink is kept and read again only when a payload is too long for it
+  TEST_CHECK(lorawan.set_ADR(SMW_SX1276M0_ADR_ON) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(0) == CommandResponse::OK);
+  TEST_CHECK(lorawan.sendT(1, "0123456789A") == CommandResponse::OK);
+  TEST_CHECK(lorawan.get_QueueCount() == 0); // (nothing queued after the uplink)
+  uint32_t commands = module.getCommandCount();
+  TEST_CHECK(lorawan.sendT(1, "0123456789A") == CommandResponse::OK);
+  TEST_CHECK(module.getCommandCount() == (commands + 1)); // (only the send)
+  TEST_CHECK(lorawan.get_TimeOnAir(11) > 0);
+  TEST_CHECK(lorawan.sendT(1, "0123456789AB") == CommandResponse::TOO_LONG); // (read again, still DR0)
+  TEST_CHECK(module.getCommandCount() == (commands + 2));
+  TEST_CHECK(lorawan.sendT(1, "0123456789A") == CommandResponse::OK);
+  SMW_SX1276M0 network(module); // (changes the data rate, as the ADR)
+  TEST_CHECK(network.set_DR(3) == CommandResponse::OK);
+  TEST_CHECK(lorawan.sendT_async(1, "0123456789AB") == CommandResponse::TOO_LONG); // (not read without blocking)
+  TEST_CHECK(lorawan.sendT(1, "0123456789AB") == CommandResponse::OK); // (read again)
+
+  // the scheduled uplinks are sent one after the other (no query of the data rate between them)
+  commands = module.getCommandCount();
+  TEST_CHECK(lorawan.schedule_sendT(1, "first", SMW_SX1276M0_PRIORITY_LOW, 60000, nullptr, nullptr));
+  TEST_CHECK(lorawan.schedule_sendT(1, "second", SMW_SX1276M0_PRIORITY_LOW, 60000, nullptr, nullptr));
+  while((lorawan.get_ScheduleCount() > 0) || (lorawan.get_QueueCount() > 0) || lorawan.isBusy()){
+    lorawan.poll();
+  }
+  TEST_CHECK(module.getCommandCount() == (commands + 2));
+
+  // data rates not defined in the region
+  TEST_CHECK(lorawan.set_ADR(SMW_SX1276M0_ADR_OFF) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_Region(SMW_SX1276M0_REGION_KR920) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(5) == CommandResponse::OK);
+  TEST_CHECK((lorawan.max_payload() == 242) && (lorawan.get_TimeOnAir(11) > 0));
+  TEST_CHECK(lorawan.set_DR(6) == CommandResponse::OK);
+  TEST_CHECK((lorawan.max_payload() == 0) && (lorawan.get_TimeOnAir(11) == 0));
+  TEST_CHECK(lorawan.set_Region(SMW_SX1276M0_REGION_EU868) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(7) == CommandResponse::OK);
+  TEST_CHECK((lorawan.max_payload() == 222) && (lorawan.get_TimeOnAir(11) > 0));
+
+  return host_test_end("payload");
+}
+
+// --------------------------------------------------
@@ -0,0 +1,192 @@
+/*******************************************************************************
+* Test of the port handlers (v1.0)
+*
+* Checks setPortHandler() and setDefaultHandler(): the handlers of colliding
+* ports, the removal, the default handler and the decoding of the
+* hexadecimal downlinks.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <vector>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Variables
+
+struct Received {
+  uint8_t port;
+  std::string data;
+  bool hex;
+  void *context;
+};
+
+std::vector<Received> received;
+uint16_t legacy = 0;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module with the last downlink given by the test
+class DownlinkModule : public ScriptedModule {
+  public:
+    std::string recv = "7:hello";
+    std::string recvb = "12:A0B1c2";
+
+    void handle(const std::string &line) override {
+      if(line == "AT+RECV"){
+        reply(recv + "\r\n<OK>\r\n");
+      } else if(line == "AT+RECVB"){
+        reply(recvb + "\r\n<OK>\r\n");
+      } else {
+        ScriptedModule::handle(line);
+      }
+    }
+};
+
+// --------------------------------------------------
+
+void event_handler(Event type){
+  (void)type;
+  legacy++;
+}
+
+// --------------------------------------------------
+
+void downlink_handler(Downlink &downlink){
+  received.push_back({ downlink.port , std::string(reinterpret_cast<const char *>(downlink.payload.data), downlink.payload.length) , downlink.hex , downlink.context });
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  DownlinkModule module;
+  SMW_SX1276M0 lorawan(module);
+  lorawan.event_listener = event_handler;
+  int a, b, d;
+
+  // colliding ports (1, 9 and 17 share a slot of the table)
+  TEST_CHECK(lorawan.setPortHandler(1, downlink_handler, &a));
+  TEST_CHECK(lorawan.setPortHandler(9, downlink_handler, &b));
+  TEST_CHECK(lorawan.setPortHandler(17, downlink_handler, &b));
+  TEST_CHECK(!lorawan.setPortHandler(0, downlink_handler));
+  TEST_CHECK(!lorawan.setPortHandler(224, downlink_handler));
+
+  module.recv = "9:x";
+  module.reply("[EVENT] RECV 1:a\r\n", 0);
+  lorawan.listen_all();
+  TEST_CHECK(received.size() == 1);
+  TEST_CHECK(legacy == 1);
+  if(received.size() == 1){
+    TEST_CHECK(received[0].port == 9);
+    TEST_CHECK(received[0].data == "x");
+    TEST_CHECK(received[0].context == &b);
+  }
+
+  // remove the first of the cluster (the others are still found)
+  TEST_CHECK(lorawan.setPortHandler(1, nullptr));
+  module.recv = "17:y";
+  module.reply("[EVENT] RECV 17:y\r\n", 0);
+  lorawan.listen_all();
+  TEST_CHECK((received.size() == 2) && (received[1].port == 17));
+
+  // port without a handler (the message is left for the events)
+  size_t reads = module.count("AT+RECV");
+  module.recv = "1:z";
+  module.reply("[EVENT] RECV 1:z\r\n[EVENT] RECVB 5:AA\r\n", 0);
+  TEST_CHECK(lorawan.listen_all() == 2);
+  TEST_CHECK(legacy == 4);
+  TEST_CHECK(module.count("AT+RECV") == reads);
+  TEST_CHECK(received.size() == 2);
+
+  // default handler
+  module.recv = "1:z";
+  lorawan.setDefaultHandler(downlink_handler, &d);
+  module.reply("[EVENT] RECV 1:a\r\n", 0);
+  lorawan.listen_all();
+  TEST_CHECK(received.size() == 3);
+  if(received.size() == 3){
+    TEST_CHECK(received[2].port == 1);
+    TEST_CHECK(received[2].context == &d);
+  }
+
+  // hexadecimal data decoded
+  lorawan.setPortHandler(12, downlink_handler, &a);
+  module.reply("[EVENT] RECVB 12:AA\r\n", 0);
+  lorawan.listen_all();
+  TEST_CHECK(received.size() == 4);
+  if(received.size() == 4){
+    TEST_CHECK(received[3].hex);
+    TEST_CHECK(received[3].data == std::string("\xA0\xB1\xC2", 3));
+    TEST_CHECK(received[3].context == &a);
+  }
+
+  // invalid hexadecimal data
+  module.recvb = "12:ABC";
+  module.reply("[EVENT] RECVB 12:AA\r\n", 0);
+  lorawan.listen_all();
+  TEST_CHECK(received.size() == 4);
+
+  // port 0 (the empty entries of the table, also after a removal)
+  SMW_SX1276M0 zero(module);
+  TEST_CHECK(zero.setPortHandler(7, downlink_handler, &a));
+  TEST_CHECK(zero.setPortHandler(9, downlink_handler, &b));
+  TEST_CHECK(zero.setPortHandler(9, nullptr));
+  size_t count_received = received.size();
+  reads = module.count("AT+RECV");
+  module.recv = ":hello";
+  module.reply("[EVENT] RECV 0:hello\r\n", 0);
+  zero.listen_all();
+  TEST_CHECK(module.count("AT+RECV") == reads); // (left for the events)
+  TEST_CHECK(received.size() == count_received);
+  zero.setDefaultHandler(downlink_handler, &d);
+  module.reply("[EVENT] RECV 0:hello\r\n", 0);
+  zero.listen_all();
+  TEST_CHECK(received.size() == (count_received + 1));
+  if(received.size() == (count_received + 1)){
+    TEST_CHECK((received.back().port == 0) && (received.back().context == &d));
+    TEST_CHECK(received.back().data == "hello");
+  }
+
+  // full table
+  SMW_SX1276M0 other(module);
+  uint8_t count = 0;
+  for(uint8_t port=1 ; port <= 20 ; port++){
+    count += other.setPortHandler(port, downlink_handler) ? 1 : 0;
+  }
+  TEST_CHECK(count == SMW_SX1276M0_PORT_HANDLERS_SIZE);
+  for(uint8_t port=1 ; port <= SMW_SX1276M0_PORT_HANDLERS_SIZE ; port++){
+    TEST_CHECK(other.setPortHandler(port, nullptr));
+  }
+  for(uint8_t port=9 ; port <= (8 + SMW_SX1276M0_PORT_HANDLERS_SIZE) ; port++){
+    TEST_CHECK(other.setPortHandler(port, downlink_handler));
+  }
+
+  return host_test_end("port handlers");
+}
+
+// --------------------------------------------------
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Test of the reset (v1.0)
+*
+* Checks that reset() and the setters that reset the module return as soon
+* as the module is ready, with the boot latency, and that a module that
+* doesn't boot gives an error after the timeout.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "SMW_SX1276M0_Emulator.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module that accepts the reset but never boots
+class DeadModule : public ScriptedModule {
+  public:
+    void handle(const std::string &line) override {
+      if(line == "AT+RESET"){
+        reply("<OK>\r\n");
+      }
+    }
+};
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  SMW_SX1276M0_Emulator module;
+  SMW_SX1276M0 lorawan(module);
+
+  // the reset returns shortly after the end of the boot
+  module.setBootTime(400);
+  uint32_t start = millis();
+  TEST_CHECK(lorawan.reset() == CommandResponse::OK);
+  uint32_t elapsed = millis() - start;
+  TEST_CHECK(lorawan.get_BootTime() >= 400);
+  TEST_CHECK(lorawan.get_BootTime() <= elapsed);
+  TEST_CHECK(elapsed < (400 + 100));
+  TEST_CHECK(module.isReady());
+
+  // longer boot
+  module.setBootTime(1500);
+  start = millis();
+  TEST_CHECK(lorawan.reset() == CommandResponse::OK);
+  TEST_CHECK(lorawan.get_BootTime() >= 1500);
+  TEST_CHECK((millis() - start) < (1500 + 100));
+
+  // the setters that reset the module
+  module.setBootTime(200);
+  start = millis();
+  TEST_CHECK(lorawan.set_JoinMode(SMW_SX1276M0_JOIN_MODE_ABP) == CommandResponse::OK);
+  TEST_CHECK((lorawan.get_BootTime() >= 200) && ((millis() - start) < (200 + 100)));
+  TEST_CHECK(strcmp(module.get(CMD_NJM), "0") == 0);
+  TEST_CHECK(lorawan.ping() == CommandResponse::OK);
+
+  // no boot
+  DeadModule dead;
+  SMW_SX1276M0 other(dead);
+  start = millis();
+  TEST_CHECK(other.reset() == CommandResponse::ERROR);
+  TEST_CHECK(other.get_BootTime() == 0);
+  TEST_CHECK((millis() - start) >= SMW_SX1276M0_TIMEOUT_RESET);
+
+  return host_test_end("reset");
+}
+
+// --------------------------------------------------
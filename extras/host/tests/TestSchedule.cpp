@@ -0,0 +1,125 @@
+/*******************************************************************************
+* Test of the schedule of uplinks (v1.0)
+*
+* Checks schedule_sendT(): the order by priority and deadline, the eviction
+* when full, the expired messages and the duty cycle between the sends.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <utility>
+#include <vector>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Variables
+
+std::vector<std::pair<std::string, CommandResponse>> results;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module in EU868 DR5 (without ADR) that stores the messages sent
+class SendModule : public ScriptedModule {
+  public:
+    std::vector<std::string> sent;
+    std::vector<uint32_t> times;
+
+    void handle(const std::string &line) override {
+      if(line.compare(0, 7, "AT+SEND") == 0){
+        sent.push_back(line.substr(line.find(':') + 1));
+        times.push_back(host_clock_millis());
+        reply("<OK>\r\n", 50);
+      } else if(line == "AT+REGION"){
+        reply("5\r\n<OK>\r\n");
+      } else if(line == "AT+DR"){
+        reply("5\r\n<OK>\r\n");
+      } else if(line == "AT+ADR"){
+        reply("0\r\n<OK>\r\n");
+      } else {
+        ScriptedModule::handle(line);
+      }
+    }
+};
+
+// --------------------------------------------------
+
+void schedule_handler(CommandResult &result){
+  results.push_back(std::make_pair(static_cast<const char *>(result.context), result.response));
+  if(result.response == CommandResponse::DROPPED){
+    TEST_CHECK(result.data == nullptr);
+  }
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  SendModule module;
+  SMW_SX1276M0 lorawan(module);
+  uint8_t value;
+  lorawan.get_Region(value);
+  lorawan.get_DR(value);
+  lorawan.get_ADR(value); // (the duty cycle is respected)
+  uint32_t off = lorawan.get_TimeOnAir(5) * 99 / 1000; // (1 % in EU868)
+  TEST_CHECK(off > 0);
+
+  TEST_CHECK(lorawan.schedule_sendT(1, "tele1", SMW_SX1276M0_PRIORITY_LOW, 600000, schedule_handler, const_cast<char *>("tele1")));
+  TEST_CHECK(lorawan.schedule_sendT(1, "tele2", SMW_SX1276M0_PRIORITY_LOW, 300000, schedule_handler, const_cast<char *>("tele2")));
+  TEST_CHECK(lorawan.schedule_sendT(1, "stale", SMW_SX1276M0_PRIORITY_LOW, 100, schedule_handler, const_cast<char *>("stale")));
+  TEST_CHECK(lorawan.schedule_sendT(1, "alarm", SMW_SX1276M0_PRIORITY_HIGH, 20000, schedule_handler, const_cast<char *>("alarm")));
+
+  // full: a low priority message is refused, a high priority one evicts
+  // the low priority message with the latest deadline
+  TEST_CHECK(!lorawan.schedule_sendT(1, "x", SMW_SX1276M0_PRIORITY_LOW, 1000, schedule_handler, const_cast<char *>("x")));
+  TEST_CHECK(lorawan.schedule_sendT(1, "alarm2", SMW_SX1276M0_PRIORITY_HIGH, 2000, schedule_handler, const_cast<char *>("alarm2")));
+  TEST_CHECK(results.size() == 1);
+  if(results.size() == 1){
+    TEST_CHECK((results[0].first == "tele1") && (results[0].second == CommandResponse::DROPPED));
+  }
+
+  // the stale message expires
+  host_clock_advance(200);
+  uint32_t timeout = millis() + 400000;
+  while((millis() < timeout) && ((lorawan.get_ScheduleCount() > 0) || (lorawan.get_QueueCount() > 0) || lorawan.isBusy())){
+    lorawan.poll();
+  }
+
+  TEST_CHECK(module.sent.size() == 3);
+  if(module.sent.size() == 3){
+    TEST_CHECK(module.sent[0] == "alarm2");
+    TEST_CHECK(module.sent[1] == "alarm");
+    TEST_CHECK(module.sent[2] == "tele2");
+    TEST_CHECK((module.times[1] - module.times[0]) >= off);
+    TEST_CHECK((module.times[2] - module.times[1]) >= off);
+  }
+  TEST_CHECK(lorawan.get_ScheduleDropped() == 2);
+  TEST_CHECK(results.size() == 5);
+
+  return host_test_end("schedule");
+}
+
+// --------------------------------------------------
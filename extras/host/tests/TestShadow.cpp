@@ -0,0 +1,128 @@
+/*******************************************************************************
+* Test of the shadow of the configuration (v1.0)
+*
+* Checks that the setters and <apply()> skip only the values that the module
+* already has: the keys are compared in full (not by a hash) and the ADR
+* invalidates the data rate and the transmission power after an uplink.
+* The profiles of <apply()> can be initialized with braces.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Constants
+
+// two keys with the same 32-bit FNV-1a hash
+const char *DEVEUI_A = "109ACFB9A2D98B80";
+const char *DEVEUI_B = "18F5D8AC974910CD";
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module with the reply of the P2P sync word given by the test
+class SyncWordModule : public ScriptedModule {
+  public:
+    std::string sync_word = ""; // (no value)
+
+    void handle(const std::string &line) override {
+      if(line == "AT+P2PSW"){
+        reply(sync_word + "\r\n<OK>\r\n");
+      } else {
+        ScriptedModule::handle(line);
+      }
+    }
+};
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  SyncWordModule module;
+  SMW_SX1276M0 lorawan(module);
+
+  // the keys
+  TEST_CHECK(lorawan.set_DevEUI(DEVEUI_A) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DevEUI(DEVEUI_A) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DevEUI("109acfb9a2d98b80") == CommandResponse::OK); // (same key)
+  TEST_CHECK(module.count("AT+DEVEUI ") == 1);
+  TEST_CHECK(lorawan.set_DevEUI(DEVEUI_B) == CommandResponse::OK);
+  TEST_CHECK(module.count("AT+DEVEUI ") == 2);
+
+  SMW_SX1276M0_Config config = SMW_SX1276M0_CONFIG_EMPTY;
+  SMW_SX1276M0_ConfigReport report;
+  config.deveui = DEVEUI_B;
+  TEST_CHECK(lorawan.apply(config, report) == CommandResponse::OK);
+  TEST_CHECK(report.status[SMW_SX1276M0_SHADOW_DEVEUI] == SMW_SX1276M0_APPLY_UNCHANGED);
+  config.deveui = DEVEUI_A;
+  TEST_CHECK(lorawan.apply(config, report) == CommandResponse::OK);
+  TEST_CHECK(report.status[SMW_SX1276M0_SHADOW_DEVEUI] == SMW_SX1276M0_APPLY_SET);
+  TEST_CHECK(module.count("AT+DEVEUI ") == 3);
+
+  // the ADR changes the data rate and the power
+  TEST_CHECK(lorawan.set_ADR(SMW_SX1276M0_ADR_ON) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(2) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_TXPower(3) == CommandResponse::OK);
+  TEST_CHECK(lorawan.sendT(1, "hello") == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(2) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_TXPower(3) == CommandResponse::OK);
+  TEST_CHECK((module.count("AT+DR ") == 2) && (module.count("AT+TXP ") == 2));
+
+  // fixed without the ADR
+  TEST_CHECK(lorawan.set_ADR(SMW_SX1276M0_ADR_OFF) == CommandResponse::OK);
+  TEST_CHECK(lorawan.sendT(1, "hello") == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_DR(2) == CommandResponse::OK);
+  TEST_CHECK(lorawan.set_TXPower(3) == CommandResponse::OK);
+  TEST_CHECK((module.count("AT+DR ") == 2) && (module.count("AT+TXP ") == 2));
+
+  // profile initialized with braces (an aggregate, also in C++11)
+  const SMW_SX1276M0_Config profile = {
+    SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET ,
+    DEVEUI_A , nullptr , nullptr , nullptr , nullptr , nullptr ,
+    SMW_SX1276M0_CONFIG_UNSET , 2 , 3 ,
+    SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET ,
+    nullptr , SMW_SX1276M0_CONFIG_UNSET ,
+    SMW_SX1276M0_CONFIG_UNSET
+  };
+  TEST_CHECK(lorawan.apply(profile, report) == CommandResponse::OK);
+  TEST_CHECK(report.status[SMW_SX1276M0_SHADOW_DEVEUI] == SMW_SX1276M0_APPLY_UNCHANGED);
+  TEST_CHECK(report.status[SMW_SX1276M0_SHADOW_DR] == SMW_SX1276M0_APPLY_UNCHANGED);
+  TEST_CHECK(report.status[SMW_SX1276M0_SHADOW_ADR] == SMW_SX1276M0_APPLY_SKIPPED);
+
+  // a response without a value doesn't update the shadow
+  uint8_t sync_word = 5;
+  TEST_CHECK(lorawan.get_P2P_SyncWord(sync_word) == CommandResponse::OK);
+  TEST_CHECK(sync_word == 5); // (unchanged)
+  TEST_CHECK(lorawan.set_P2P_SyncWord(5) == CommandResponse::OK);
+  TEST_CHECK(module.count("AT+P2PSW ") == 1);
+  module.sync_word = "123456"; // (too long)
+  TEST_CHECK(lorawan.get_P2P_SyncWord(sync_word) == CommandResponse::OK);
+  TEST_CHECK(sync_word == 123);
+
+  return host_test_end("shadow");
+}
+
+// --------------------------------------------------
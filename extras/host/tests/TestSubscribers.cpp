@@ -0,0 +1,136 @@
+/*******************************************************************************
+* Test of the event subscribers (v1.0)
+*
+* Checks subscribe() and unsubscribe(): the masks, the context and the data
+* given to each subscriber, the events received during a command and the
+* legacy listener.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <vector>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Variables
+
+struct Subscriber {
+  std::vector<EventInfo> events;
+};
+
+uint16_t legacy = 0;
+SMW_SX1276M0 *driver = nullptr;
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+void event_handler(Event type){
+  (void)type;
+  legacy++;
+}
+
+// --------------------------------------------------
+
+void subscriber_handler(EventInfo &info){
+  static_cast<Subscriber *>(info.context)->events.push_back(info);
+}
+
+// --------------------------------------------------
+
+void once_handler(EventInfo &info){
+  static_cast<Subscriber *>(info.context)->events.push_back(info);
+  driver->unsubscribe(once_handler, info.context); // (during the call)
+}
+
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+
+  ScriptedModule module;
+  SMW_SX1276M0 lorawan(module);
+  lorawan.event_listener = event_handler;
+
+  Subscriber all, downlinks, joins;
+  TEST_CHECK(lorawan.subscribe(subscriber_handler, &all));
+  TEST_CHECK(lorawan.subscribe(subscriber_handler, &downlinks, SMW_SX1276M0_EVENT_MASK(Event::RECEIVED) | SMW_SX1276M0_EVENT_MASK(Event::RECEIVED_X)));
+  TEST_CHECK(lorawan.subscribe(subscriber_handler, &joins, SMW_SX1276M0_EVENT_MASK(Event::JOINED)));
+
+  // events received while idle
+  module.reply("[EVENT] JOINED\r\n[EVENT] RECVB 12:AABBCC\r\n[EVENT] RECV 7:hello\r\n", 0);
+  TEST_CHECK(lorawan.listen_all() == 3);
+  TEST_CHECK(legacy == 3);
+  TEST_CHECK(all.events.size() == 3);
+  TEST_CHECK(downlinks.events.size() == 2);
+  TEST_CHECK(joins.events.size() == 1);
+  if(downlinks.events.size() == 2){
+    TEST_CHECK(downlinks.events[0].event == Event::RECEIVED_X);
+    TEST_CHECK(downlinks.events[0].port == 12);
+    TEST_CHECK(downlinks.events[0].length == 3);
+    TEST_CHECK(downlinks.events[1].event == Event::RECEIVED);
+    TEST_CHECK(downlinks.events[1].port == 7);
+    TEST_CHECK(downlinks.events[1].length == 5);
+    TEST_CHECK(downlinks.events[1].context == &downlinks);
+  }
+
+  // event received during a command (delivered afterwards, with its time)
+  module.reply("5\r\n[EVENT] RECVB 3:0102\r\n<OK>\r\n", 3);
+  uint8_t dr = 0;
+  TEST_CHECK(lorawan.get_DR(dr) == CommandResponse::OK);
+  TEST_CHECK(dr == 5);
+  uint32_t time = millis();
+  lorawan.poll();
+  TEST_CHECK(downlinks.events.size() == 3);
+  if(downlinks.events.size() == 3){
+    TEST_CHECK(downlinks.events[2].port == 3);
+    TEST_CHECK(downlinks.events[2].length == 2);
+    TEST_CHECK(downlinks.events[2].time < time);
+  }
+
+  // unsubscribe
+  TEST_CHECK(lorawan.unsubscribe(subscriber_handler, &all));
+  TEST_CHECK(!lorawan.unsubscribe(subscriber_handler, &all));
+  module.reply("[EVENT] SLEEP\r\n", 0);
+  lorawan.listen_all();
+  TEST_CHECK(all.events.size() == 4); // (3 + the RECVB during the command)
+  TEST_CHECK(joins.events.size() == 1);
+
+  // unsubscribe during the call (the next subscribers still receive the event)
+  driver = &lorawan;
+  Subscriber once, after;
+  TEST_CHECK(lorawan.subscribe(once_handler, &once));
+  TEST_CHECK(lorawan.subscribe(subscriber_handler, &after));
+  module.reply("[EVENT] JOINED\r\n[EVENT] JOINED\r\n", 0);
+  TEST_CHECK(lorawan.listen_all() == 2);
+  TEST_CHECK(once.events.size() == 1);
+  TEST_CHECK(after.events.size() == 2);
+  TEST_CHECK(joins.events.size() == 3);
+  TEST_CHECK(!lorawan.unsubscribe(once_handler, &once)); // (removed)
+  TEST_CHECK(lorawan.subscribe(once_handler, &once)); // (the entry is free)
+
+  return host_test_end("subscribers");
+}
+
+// --------------------------------------------------
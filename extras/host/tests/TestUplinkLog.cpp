@@ -0,0 +1,279 @@
+/*******************************************************************************
+* Test of the store-and-forward log (v1.0)
+*
+* Checks that the uplink log keeps the records across the reboots (the file
+* is reopened), overwrites the oldest records when full, behaves as a queue
+* in a long random sequence and is sent in order by forward(), which removes
+* the records longer than the maximum payload.
+*
+* Copyright 2022 RoboCore.
+*
+*
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+*
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Libraries
+
+#include <deque>
+
+#include "RoboCore_SMW_SX1276M0.h"
+#include "FileLogStorage.h"
+#include "HostTest.h"
+#include "ScriptedModule.h"
+
+// --------------------------------------------------
+// Constants
+
+const char *LOG_PATH = "uplink_log.bin"; // (in the folder of the tests)
+const uint8_t LOG_DATA_SIZE = 8;
+const uint16_t LOG_CAPACITY = 10;
+const uint32_t LOG_SIZE = LOG_CAPACITY * (UPLINK_LOG_HEADER_SIZE + LOG_DATA_SIZE) + 7; // (with unused bytes at the end)
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Module that is joined (in US915 DR3) and stores the payloads sent
+class UplinkModule : public ScriptedModule {
+  public:
+    std::vector<std::string> payloads; // the payloads sent (<port>:<data>)
+    bool fail = false;
+
+    void handle(const std::string &line) override {
+      if(line == "AT+NJS"){
+        reply("1\r\n<OK>\r\n");
+      } else if(line == "AT+REGION"){
+        reply("8\r\n<OK>\r\n");
+      } else if(line == "AT+DR"){
+        reply("3\r\n<OK>\r\n");
+      } else if(line.compare(0, 9, "AT+SENDB ") == 0){
+        if(fail){
+          reply("<Failed>\r\n");
+        } else {
+          payloads.push_back(line.substr(9));
+          reply("<OK>\r\n", 50);
+        }
+      } else {
+        reply("<OK>\r\n");
+      }
+    }
+};
+
+// --------------------------------------------------
+
+// A record of the model of the log
+struct Record {
+  uint8_t port;
+  std::vector<uint8_t> data;
+};
+
+uint32_t seed = 12345;
+
+// Get a pseudo-random number (LCG)
+//  @param (max) : the maximum (exclusive) [uint32_t]
+//  @returns the number [uint32_t]
+uint32_t next_random(uint32_t max){
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) % max;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+int main(void){
+  host_clock_virtual(true);
+  remove(LOG_PATH);
+
+  // overflow (the oldest records are overwritten)
+  {
+    FileLogStorage storage(LOG_PATH, LOG_SIZE);
+    UplinkLog log(storage, LOG_DATA_SIZE);
+    TEST_CHECK(log.begin());
+    TEST_CHECK((log.capacity() == LOG_CAPACITY) && (log.available() == 0));
+
+    UplinkModule module;
+    SMW_SX1276M0 lorawan(module); // (not connected)
+    for(uint8_t i=0 ; i < 13 ; i++){
+      uint8_t data[3] = { i , i , i };
+      TEST_CHECK(lorawan.log_sendX(log, 2, data, sizeof(data)) == CommandResponse::OK);
+    }
+    TEST_CHECK(module.payloads.empty());
+    TEST_CHECK((log.available() == LOG_CAPACITY) && (log.dropped() == 3));
+
+    uint8_t big[LOG_DATA_SIZE + 1] = { 0 };
+    TEST_CHECK(lorawan.log_sendX(log, 2, big, sizeof(big)) == CommandResponse::ERROR);
+    TEST_CHECK(log.available() == LOG_CAPACITY);
+  }
+
+  // reboot: the records are found in the file and sent in order
+  {
+    FileLogStorage storage(LOG_PATH, LOG_SIZE);
+    UplinkLog log(storage, LOG_DATA_SIZE);
+    TEST_CHECK(log.begin() && (log.available() == LOG_CAPACITY));
+
+    UplinkModule module;
+    SMW_SX1276M0 lorawan(module);
+    uint8_t status;
+    TEST_CHECK(lorawan.get_JoinStatus(status) == CommandResponse::OK);
+    TEST_CHECK(lorawan.isConnected());
+    lorawan.setDutyCycle(false);
+
+    for(uint8_t i=0 ; i < 4 ; i++){
+      TEST_CHECK(lorawan.forward(log) == CommandResponse::OK);
+    }
+    module.fail = true;
+    TEST_CHECK(lorawan.forward(log) == CommandResponse::FAILED);
+    TEST_CHECK(log.available() == 6); // (kept)
+    module.fail = false;
+
+    // stored after the pending records (to keep the order)
+    uint8_t data[2] = { 0xAB , 0xCD };
+    TEST_CHECK(lorawan.log_sendX(log, 3, data, sizeof(data)) == CommandResponse::OK);
+    TEST_CHECK(log.available() == 7);
+    TEST_CHECK((module.payloads.size() == 4) && (module.payloads[0] == "2:030303") && (module.payloads[3] == "2:060606"));
+  }
+
+  // reboot: the rest of the records
+  {
+    FileLogStorage storage(LOG_PATH, LOG_SIZE);
+    UplinkLog log(storage, LOG_DATA_SIZE);
+    TEST_CHECK(log.begin() && (log.available() == 7));
+
+    UplinkModule module;
+    SMW_SX1276M0 lorawan(module);
+    uint8_t status;
+    TEST_CHECK(lorawan.get_JoinStatus(status) == CommandResponse::OK);
+    lorawan.setDutyCycle(false);
+    while(log.available() > 0){
+      if(lorawan.forward(log) != CommandResponse::OK){
+        break;
+      }
+    }
+    TEST_CHECK(module.payloads.size() == 7);
+    TEST_CHECK((module.payloads[0] == "2:070707") && (module.payloads[5] == "2:0C0C0C") && (module.payloads[6] == "3:ABCD"));
+    TEST_CHECK(lorawan.forward(log) == CommandResponse::ERROR); // (empty)
+  }
+
+  // the data size is limited to the buffer of forward()
+  {
+    FileLogStorage storage(LOG_PATH, LOG_SIZE);
+    UplinkLog log(storage, UPLINK_LOG_DATA_SIZE + 10);
+    TEST_CHECK(log.data_size() == UPLINK_LOG_DATA_SIZE);
+  }
+
+  // random sequence against a model (a deque), with reboots
+  {
+    std::deque<Record> model;
+    uint32_t dropped = 0;
+    uint32_t errors = 0;
+    FileLogStorage *storage = nullptr;
+    UplinkLog *log = nullptr;
+    for(uint16_t k=0 ; k < 2000 ; k++){
+      if((k % 97) == 0){
+        // reboot (and the records of the previous tests)
+        delete log;
+        delete storage;
+        storage = new FileLogStorage(LOG_PATH, LOG_SIZE);
+        log = new UplinkLog(*storage, LOG_DATA_SIZE);
+        if(!log->begin()){
+          errors++;
+        }
+        if(k == 0){
+          log->clear();
+        }
+        dropped = 0;
+      }
+
+      uint32_t operation = next_random(10);
+      if(operation < 5){
+        Record record;
+        record.port = 1 + next_random(223);
+        record.data.resize(next_random(LOG_DATA_SIZE + 1));
+        for(uint8_t &byte : record.data){
+          byte = next_random(256);
+        }
+        if(!log->append(record.port, record.data.data(), record.data.size())){
+          errors++;
+        }
+        model.push_back(record);
+        if(model.size() > LOG_CAPACITY){
+          model.pop_front();
+          dropped++;
+        }
+      } else if(operation < 8){
+        if(log->pop() != !model.empty()){
+          errors++;
+        }
+        if(!model.empty()){
+          model.pop_front();
+        }
+      } else {
+        uint8_t port;
+        uint8_t data[LOG_DATA_SIZE];
+        uint8_t length;
+        bool res = log->peek(port, data, length);
+        if(res != !model.empty()){
+          errors++;
+        } else if(res && ((port != model.front().port) || (length != model.front().data.size()) ||
+            ((length > 0) && (memcmp(data, model.front().data.data(), length) != 0)))){
+          errors++;
+        }
+      }
+
+      if((log->available() != model.size()) || (log->dropped() != dropped)){
+        errors++;
+      }
+    }
+    delete log;
+    delete storage;
+    TEST_CHECK(errors == 0);
+  }
+
+  // a record longer than the maximum payload (the data rate was lowered) is removed
+  remove(LOG_PATH);
+  {
+    FileLogStorage storage(LOG_PATH, LOG_SIZE);
+    UplinkLog log(storage); // (the maximum data size)
+    TEST_CHECK(log.begin());
+
+    UplinkModule module;
+    SMW_SX1276M0 lorawan(module); // (not connected)
+    lorawan.setDutyCycle(false);
+    TEST_CHECK(lorawan.set_ADR(SMW_SX1276M0_ADR_OFF) == CommandResponse::OK);
+    TEST_CHECK(lorawan.max_payload() == 242); // (read)
+    uint8_t data[UPLINK_LOG_DATA_SIZE] = { 0 };
+    TEST_CHECK(lorawan.log_sendX(log, 4, data, sizeof(data)) == CommandResponse::OK);
+    TEST_CHECK(lorawan.log_sendX(log, 5, data, 2) == CommandResponse::OK);
+    TEST_CHECK(log.available() == 2);
+
+    TEST_CHECK(lorawan.set_DR(0) == CommandResponse::OK); // (11 bytes)
+    uint8_t status;
+    TEST_CHECK(lorawan.get_JoinStatus(status) == CommandResponse::OK);
+    TEST_CHECK(lorawan.forward(log) == CommandResponse::TOO_LONG);
+    TEST_CHECK((log.available() == 1) && (log.rejected() == 1) && (log.dropped() == 0));
+    uint8_t calls = 0;
+    while((log.available() > 0) && (calls < 10)){
+      lorawan.forward(log);
+      calls++;
+    }
+    TEST_CHECK((calls == 1) && (module.payloads.size() == 1) && (module.payloads[0] == "5:0000"));
+  }
+
+  remove(LOG_PATH);
+  return host_test_end("uplink log");
+}
+
+// --------------------------------------------------
@@ -0,0 +1,46 @@
+#!/bin/sh
+#
+# Compile and run the tests of the library on the computer (Linux).
+#
+# Usage (from the root of the library):
+#   sh extras/host/tests/run_tests.sh [Test.cpp ...]
+#
+# Without arguments, all the tests (Test*.cpp) are run. The exit code is 0
+# only if all the tests pass.
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:-"-std=gnu++11 -O1"}
+HOST=extras/host
+TESTS=$HOST/tests
+OUT=${OUT:-/tmp/smw_sx1276m0_tests}
+
+mkdir -p "$OUT" || exit 1
+
+# compile the library and the host files once
+OBJECTS=""
+for source in src/*.cpp $HOST/*.cpp; do
+  object="$OUT/$(basename "$source" .cpp).o"
+  $CXX $CXXFLAGS -I$HOST -Isrc -c "$source" -o "$object" || exit 1
+  OBJECTS="$OBJECTS $object"
+done
+
+if [ $# -eq 0 ]; then
+  set -- $TESTS/Test*.cpp
+fi
+
+failures=0
+for test in "$@"; do
+  program="$OUT/$(basename "$test" .cpp)"
+  if ! $CXX $CXXFLAGS -I$HOST -I$TESTS -Isrc "$test" $OBJECTS -o "$program"; then
+    echo "$test: BUILD FAILED"
+    failures=$((failures + 1))
+    continue
+  fi
+  (cd "$OUT" && "$program") || failures=$((failures + 1))
+done
+
+if [ $failures -gt 0 ]; then
+  echo "$failures test(s) failed"
+  exit 1
+fi
+echo "All tests passed"
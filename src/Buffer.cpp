@@ -1,7 +1,7 @@
 /*******************************************************************************
-* RoboCore Buffer Library (v1.0)
+* RoboCore Buffer Library (v1.1)
 * 
-* Library to manipulate buffers.
+* Library to manipulate buffers (circular, for constant time access).
 * 
 * Copyright 2022 RoboCore.
 * Written by Francois (24/08/2020).
@@ -44,8 +44,9 @@ Buffer::Buffer() : Buffer(1) {
 // --------------------------------------------------
 
 // Constructor
-//  @param (size) : the size of the buffer in bytes [uint8_t]
-Buffer::Buffer(uint8_t size) :
+//  @param (size) : the size of the buffer in bytes [uint16_t]
+Buffer::Buffer(uint16_t size) :
+  _owner(true),
   _size(size)
   {
   // check the size
@@ -60,14 +61,30 @@ Buffer::Buffer(uint8_t size) :
 
 // --------------------------------------------------
 
+// Constructor (external memory)
+//  @param (storage) : the memory to use, which must outlive the object [uint8_t *]
+//         (size)    : the size of the memory in bytes [uint16_t]
+Buffer::Buffer(uint8_t *storage, uint16_t size) :
+  _owner(false),
+  _size(size),
+  _buffer(storage)
+  {
+  reset();
+}
+
+// --------------------------------------------------
+
 // Copy constructor
 //  @param (buffer) : the buffer to copy [Buffer]
 Buffer::Buffer(const Buffer& buffer) :
+  _owner(true),
+  _head(buffer._head),
   _index(buffer._index),
-  _size(buffer._size)
+  _size(buffer._size),
+  _overflow(buffer._overflow)
   {
   _buffer = new uint8_t[_size]; // allocate the memory
-  for(uint8_t i=0 ; i < _size ; i++){
+  for(uint16_t i=0 ; i < _size ; i++){
     _buffer[i] = buffer._buffer[i];
   }
 }
@@ -77,7 +94,9 @@ Buffer::Buffer(const Buffer& buffer) :
 // Destructor
 Buffer::~Buffer(){
 //  free(_buffer); // 15/04/20 : old version
-  delete[] _buffer; // free the memory
+  if(_owner){
+    delete[] _buffer; // free the memory
+  }
 }
 
 // --------------------------------------------------
@@ -89,13 +108,27 @@ Buffer& Buffer::operator=(const Buffer& buffer){
     return *this;
   }
 
+  // copy into the external memory (limited by its size)
+  if(!_owner){
+    _head = 0;
+    _index = (buffer._index < _size) ? buffer._index : _size;
+    uint32_t overflow = static_cast<uint32_t>(buffer._overflow) + (buffer._index - _index);
+    _overflow = (overflow < UINT16_MAX) ? overflow : UINT16_MAX; // (saturated, as in <append()>)
+    for(uint16_t i=0 ; i < _index ; i++){
+      _buffer[i] = buffer[i];
+    }
+    return *this;
+  }
+
   if(_buffer){
     delete[] _buffer;
   }
   _size = buffer._size;
+  _head = buffer._head;
   _index = buffer._index;
+  _overflow = buffer._overflow;
   _buffer = new uint8_t[_size]; // allocate the memory
-  for(uint8_t i=0 ; i < _size ; i++){
+  for(uint16_t i=0 ; i < _size ; i++){
     _buffer[i] = buffer._buffer[i];
   }
 
@@ -106,13 +139,16 @@ Buffer& Buffer::operator=(const Buffer& buffer){
 
 // Operator [] (subscript)
 //  @returns the value of the last index if out of bounds [const uint8_t]
-const uint8_t& Buffer::operator[](uint8_t index) const {
+const uint8_t& Buffer::operator[](uint16_t index) const {
   // check the index
   if(index >= _index){
-    return _buffer[_index - 1]; // return from the last index
+    if(_index == 0){
+      return _buffer[_head]; // empty buffer
+    }
+    return _buffer[_position(_index - 1)]; // return from the last index
   }
 
-  return _buffer[index];
+  return _buffer[_position(index)];
 }
 
 // --------------------------------------------------
@@ -122,18 +158,18 @@ const uint8_t& Buffer::operator[](uint8_t index) const {
 //  @param (b) the byte to append [uint8_t]
 void Buffer::append(uint8_t b){
   if(!isFull()){
-    _buffer[_index++] = b;
-  }
-  if(_index > _size){
-    _index = _size; // udpate
+    _buffer[_position(_index)] = b;
+    _index++;
+  } else if(_overflow < UINT16_MAX){
+    _overflow++; // count the discarded byte
   }
 }
 
 // --------------------------------------------------
 
 // Check if there is data available
-//  @returns the quantity of bytes stored [uint8_t]
-uint8_t Buffer::available(void){
+//  @returns the quantity of bytes stored [uint16_t]
+uint16_t Buffer::available(void){
   return _index;
 }
 
@@ -142,7 +178,42 @@ uint8_t Buffer::available(void){
 // Get a copy of the buffer
 //  @param (data) : the array to copy to [uint8_t *]
 void Buffer::copy(uint8_t *data){
-  memcpy(data, _buffer, _index);
+  // copy up to the end of the array and then from its beginning (if wrapped)
+  uint16_t length = _size - _head;
+  if(length > _index){
+    length = _index;
+  }
+  memcpy(data, &_buffer[_head], length);
+  memcpy(&data[length], _buffer, _index - length);
+}
+
+// --------------------------------------------------
+
+// Get a pointer to the data, without copying it
+//  @returns the pointer to the first byte [const uint8_t *]
+//  NOTE: the data is rearranged to be contiguous if necessary (rare, because
+//        the head restarts at the beginning of the array on every reset)
+//  NOTE: the pointer is valid until the buffer is modified
+const uint8_t * Buffer::data(void){
+  // check if the data is wrapped around the end of the array
+  if((_head > 0) && ((_size - _head) < _index)){
+    // rotate the array to the left by <_head> positions (with three reversals)
+    uint16_t parts[3][2] = { { 0 , _head } , { _head , _size } , { 0 , _size } };
+    for(uint8_t p=0 ; p < 3 ; p++){
+      uint16_t i = parts[p][0];
+      uint16_t j = parts[p][1];
+      while(i + 1 < j){
+        j--;
+        uint8_t temp = _buffer[i];
+        _buffer[i] = _buffer[j];
+        _buffer[j] = temp;
+        i++;
+      }
+    }
+    _head = 0;
+  }
+
+  return &_buffer[_head];
 }
 
 // --------------------------------------------------
@@ -158,6 +229,15 @@ bool Buffer::isFull(void){
 
 // --------------------------------------------------
 
+// Get the quantity of bytes discarded because the buffer was full
+//  @returns the quantity of bytes since the last reset [uint16_t]
+//  NOTE: the size required for the data is <available() + overflow()>
+uint16_t Buffer::overflow(void){
+  return _overflow;
+}
+
+// --------------------------------------------------
+
 // Check the first byte in the buffer
 //  @returns [uint8_t]
 uint8_t Buffer::peek(void){
@@ -165,7 +245,7 @@ uint8_t Buffer::peek(void){
     return 0;
   }
 
-  return _buffer[0];
+  return _buffer[_head];
 }
 
 
@@ -181,8 +261,8 @@ void Buffer::print(Stream *stream){
     stream->print('|');
     stream->print(_index); // is the same as <available()>
     stream->print('|');
-    for(uint8_t i=0 ; i < _index ; i++){
-      stream->write(_buffer[i]);
+    for(uint16_t i=0 ; i < _index ; i++){
+      stream->write(_buffer[_position(i)]);
     }
     stream->println();
   }
@@ -196,13 +276,13 @@ void Buffer::print(Stream *stream){
 uint8_t Buffer::read(void){
   uint8_t ret = peek();
 
-  // shift the buffer
+  // move the head
   if(_index > 0){
-    for(uint8_t i=0 ; i < (_index - 1) ; i++){
-      _buffer[i] = _buffer[i+1];
-    }
+    _head = _position(1);
     _index--; // update
-    _buffer[_index] = 0; // reset
+    if(_index == 0){
+      _head = 0; // restart from the beginning, so the data stays contiguous
+    }
   }
   
   return ret;
@@ -212,49 +292,63 @@ uint8_t Buffer::read(void){
 
 // Reset the buffer
 void Buffer::reset(void){
+  _head = 0;
   _index = 0;
-  for(uint8_t i=0 ; i < _size ; i++){
-    _buffer[i] = 0;
-  }
+  _overflow = 0;
+  // NOTE: the data is not cleared, because it is never read beyond <_index>
 }
 
 
 // --------------------------------------------------
 
 // Resize the buffer
-//  @param (size) : the size of the buffer in bytes [uint8_t]
-void Buffer::resize(uint8_t size){
-  // check the new size
-  if(size == 0){
+//  @param (size) : the size of the buffer in bytes [uint16_t]
+void Buffer::resize(uint16_t size){
+  // check the new size (the external memory cannot be resized)
+  if((size == 0) || !_owner){
     return;
   }
   
   // allocate the memory
   uint8_t *_new_buffer = new uint8_t[size];
 
-  // copy the data
-  uint8_t copy_size = (size < _size) ? size : _size;
-  for(uint8_t i=0 ; i < copy_size ; i++){
-    _new_buffer[i] = _buffer[i];
-  }
-
   // validate the index
   if(_index > size){
     _index = size;
   }
 
+  // copy the data (from the head)
+  for(uint16_t i=0 ; i < _index ; i++){
+    _new_buffer[i] = _buffer[_position(i)];
+  }
+
   // update the references
   delete[] _buffer;
   _buffer = _new_buffer;
+  _head = 0;
   _size = size;
 }
 
 // --------------------------------------------------
 
 // Get the size of the buffer
-//  @returns the size of the buffer [uint8_t]
-uint8_t Buffer::size(void){
+//  @returns the size of the buffer [uint16_t]
+uint16_t Buffer::size(void){
   return _size;
 }
 
 // --------------------------------------------------
+// --------------------------------------------------
+
+// Get the position in the array of an index relative to the head
+//  @param (index) : the index relative to the head [uint16_t]
+//  @returns the position in the array [uint16_t]
+uint16_t Buffer::_position(uint16_t index) const {
+  uint32_t position = _head + index; // (larger type to prevent overflow)
+  if(position >= _size){
+    position -= _size; // wrap around (faster than the modulo)
+  }
+  return position;
+}
+
+// --------------------------------------------------
@@ -2,9 +2,9 @@
 #define BUFFER_H
 
 /*******************************************************************************
-* RoboCore Buffer Library (v1.0)
+* RoboCore Buffer Library (v1.1)
 * 
-* Library to manipulate buffers.
+* Library to manipulate buffers (circular, for constant time access).
 * 
 * Copyright 2022 RoboCore.
 * Written by Francois (24/08/2020).
@@ -44,31 +44,61 @@ extern "C" {
 class Buffer {
   public:
     Buffer();
-    Buffer(uint8_t);
+    Buffer(uint16_t);
     Buffer(const Buffer&);
     ~Buffer();
     void append(uint8_t);
-    uint8_t available(void);
+    uint16_t available(void);
     void copy(uint8_t *);
+    const uint8_t * data(void);
     bool isFull(void);
     uint8_t peek(void);
     uint8_t read(void);
     void reset(void);
-    void resize(uint8_t);
-    uint8_t size(void);
+    void resize(uint16_t);
+    uint16_t overflow(void);
+    uint16_t size(void);
 
     Buffer& operator=(const Buffer&);
 
-    const uint8_t& operator[](uint8_t) const;
+    const uint8_t& operator[](uint16_t) const;
 
 #ifdef BUFFER_DEBUG
     void print(Stream *);
 #endif
+
+  protected:
+    Buffer(uint8_t *, uint16_t);
   
   private:
-    uint8_t _index;
-    uint8_t _size;
+    bool _owner; // true if the memory was allocated by the object
+    uint16_t _head; // the position of the first byte
+    uint16_t _index; // the quantity of bytes stored
+    uint16_t _size;
+    uint16_t _overflow; // the quantity of bytes discarded because the buffer was full
     uint8_t *_buffer;
+
+    uint16_t _position(uint16_t) const;
+};
+
+// -----------------------------------------------------------------
+
+// Buffer with the memory reserved at compile time (no heap allocation)
+//  NOTE: the size is fixed, so <resize()> has no effect
+template <uint16_t N>
+class StaticBuffer : public Buffer {
+  public:
+    StaticBuffer() : Buffer(_storage, N) {}
+    StaticBuffer(const StaticBuffer& buffer) : Buffer(_storage, N) { *this = buffer; }
+
+    StaticBuffer& operator=(const StaticBuffer& buffer){
+      Buffer::operator=(buffer);
+      return *this;
+    }
+    using Buffer::operator=;
+
+  private:
+    uint8_t _storage[N];
 };
 
 // -----------------------------------------------------------------
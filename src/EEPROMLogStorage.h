@@ -0,0 +1,89 @@
+#ifndef EEPROM_LOG_STORAGE_H
+#define EEPROM_LOG_STORAGE_H
+
+/*******************************************************************************
+* RoboCore EEPROM Log Storage (v1.0)
+* 
+* Storage of the uplink log in the EEPROM (see "UplinkLog.h").
+* 
+* Copyright 2022 RoboCore.
+* 
+* 
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+* 
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// NOTE: this file is not included by the library, so that the EEPROM library
+//       is only required by the sketches that use it
+
+// --------------------------------------------------
+// Dependencies
+
+#include <EEPROM.h>
+
+#include "UplinkLog.h"
+
+// -----------------------------------------------------------------
+
+// Storage of the log in an area of the EEPROM
+//  NOTE: on the ESP32 (emulated EEPROM), <EEPROM.begin()> must be called
+//        before, with a size that includes the area
+class EEPROMLogStorage : public LogStorage {
+  public:
+    EEPROMLogStorage(uint16_t address, uint16_t size) :
+      _address(address),
+      _size(size)
+      {}
+
+    bool read(uint32_t address, uint8_t *data, uint16_t length) override {
+      if((address + length) > _size){
+        return false;
+      }
+      for(uint16_t i=0 ; i < length ; i++){
+        data[i] = EEPROM.read(_address + address + i);
+      }
+      return true;
+    }
+
+    uint32_t size(void) override {
+      return _size;
+    }
+
+    bool write(uint32_t address, const uint8_t *data, uint16_t length) override {
+      if((address + length) > _size){
+        return false;
+      }
+      for(uint16_t i=0 ; i < length ; i++){
+#if defined(ESP32) || defined(ESP8266)
+        EEPROM.write(_address + address + i, data[i]);
+#else
+        EEPROM.update(_address + address + i, data[i]); // (only the bytes that changed)
+#endif
+      }
+#if defined(ESP32) || defined(ESP8266)
+      return EEPROM.commit();
+#else
+      return true;
+#endif
+    }
+
+  private:
+    uint16_t _address; // the start of the area
+    uint16_t _size;
+};
+
+// -----------------------------------------------------------------
+
+#endif // EEPROM_LOG_STORAGE_H
@@ -0,0 +1,161 @@
+/*******************************************************************************
+* RoboCore Fragment Library (v1.0)
+* 
+* Library to reassemble the messages split in fragments (see <sendFragmented()>).
+* 
+* Copyright 2022 RoboCore.
+* 
+* 
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+* 
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+#include "Fragment.h"
+
+// --------------------------------------------------
+// Dependencies
+
+extern "C" {
+  #include <string.h>
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Constructor
+//  @param (buffer) : the buffer to store the message [uint8_t *]
+//         (size)   : the size of the buffer in bytes [uint16_t]
+//  NOTE: the buffer must outlive the object
+SMW_SX1276M0_Reassembler::SMW_SX1276M0_Reassembler(uint8_t *buffer, uint16_t size) :
+  _buffer(buffer),
+  _size(size)
+  {
+  reset();
+}
+
+// --------------------------------------------------
+
+// Add a fragment
+//  @param (fragment) : the fragment received (header and data) [uint8_t *]
+//         (length)   : the length of the fragment [uint16_t]
+//  @returns SMW_SX1276M0_FRAGMENT_INCOMPLETE, SMW_SX1276M0_FRAGMENT_COMPLETE or SMW_SX1276M0_FRAGMENT_INVALID [uint8_t]
+uint8_t SMW_SX1276M0_Reassembler::add(const uint8_t *fragment, uint16_t length){
+  // check the header
+  if((fragment == nullptr) || (length < SMW_SX1276M0_FRAGMENT_HEADER_SIZE)){
+    return SMW_SX1276M0_FRAGMENT_INVALID;
+  }
+  uint8_t id = fragment[SMW_SX1276M0_FRAGMENT_HEADER_ID];
+  uint8_t index = fragment[SMW_SX1276M0_FRAGMENT_HEADER_INDEX];
+  uint8_t count = fragment[SMW_SX1276M0_FRAGMENT_HEADER_COUNT];
+  if((count == 0) || (index >= count)){
+    return SMW_SX1276M0_FRAGMENT_INVALID;
+  }
+  const uint8_t *data = fragment + SMW_SX1276M0_FRAGMENT_HEADER_SIZE;
+  length -= SMW_SX1276M0_FRAGMENT_HEADER_SIZE;
+
+  // start a new message
+  if((_count == 0) || (id != _id) || (count != _count) || isComplete()){
+    reset();
+    _id = id;
+    _count = count;
+  }
+
+  // check if already received
+  if(_map[index / 8] & (1 << (index % 8))){
+    return isComplete() ? SMW_SX1276M0_FRAGMENT_COMPLETE : SMW_SX1276M0_FRAGMENT_INCOMPLETE;
+  }
+
+  bool last = (index == (_count - 1));
+  if(!last){
+    if(_chunk == 0){
+      _chunk = length; // learn the size
+    } else if(length != _chunk){
+      return SMW_SX1276M0_FRAGMENT_INVALID;
+    }
+  } else if(_count > 1){
+    if((_chunk == 0) || (length > _chunk)){
+      return SMW_SX1276M0_FRAGMENT_INVALID; // the position isn't known yet (or invalid size)
+    }
+  }
+
+  // store the data
+  uint32_t offset = static_cast<uint32_t>(index) * _chunk;
+  if((offset + length) > _size){
+    return SMW_SX1276M0_FRAGMENT_INVALID; // overflow
+  }
+  memcpy(&_buffer[offset], data, length);
+  _map[index / 8] |= (1 << (index % 8));
+  _received++;
+  if(last){
+    _length = offset + length;
+  }
+
+  return isComplete() ? SMW_SX1276M0_FRAGMENT_COMPLETE : SMW_SX1276M0_FRAGMENT_INCOMPLETE;
+}
+
+// --------------------------------------------------
+
+// Get the data of the message
+//  @returns a pointer to the data [uint8_t *]
+//  NOTE: valid only when the message is complete
+const uint8_t * SMW_SX1276M0_Reassembler::data(void){
+  return _buffer;
+}
+
+// --------------------------------------------------
+
+// Get the ID of the current message
+//  @returns the message ID [uint8_t]
+uint8_t SMW_SX1276M0_Reassembler::id(void){
+  return _id;
+}
+
+// --------------------------------------------------
+
+// Check if the message is complete
+//  @returns true if all the fragments were received [bool]
+bool SMW_SX1276M0_Reassembler::isComplete(void){
+  return ((_count > 0) && (_received == _count));
+}
+
+// --------------------------------------------------
+
+// Get the length of the message
+//  @returns the length in bytes (0 if not complete) [uint16_t]
+uint16_t SMW_SX1276M0_Reassembler::length(void){
+  return isComplete() ? _length : 0;
+}
+
+// --------------------------------------------------
+
+// Get the number of fragments missing
+//  @returns the number of fragments [uint8_t]
+uint8_t SMW_SX1276M0_Reassembler::missing(void){
+  return _count - _received;
+}
+
+// --------------------------------------------------
+
+// Reset the reassembler (discard the current message)
+void SMW_SX1276M0_Reassembler::reset(void){
+  _chunk = 0;
+  _length = 0;
+  _id = 0;
+  _count = 0;
+  _received = 0;
+  memset(_map, 0, sizeof(_map));
+}
+
+// --------------------------------------------------
@@ -0,0 +1,92 @@
+#ifndef SMW_SX1276M0_FRAGMENT_H
+#define SMW_SX1276M0_FRAGMENT_H
+
+/*******************************************************************************
+* RoboCore Fragment Library (v1.0)
+* 
+* Library to reassemble the messages split in fragments (see <sendFragmented()>).
+* 
+* Copyright 2022 RoboCore.
+* 
+* 
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+* 
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+extern "C" {
+  #include <stdint.h>
+}
+
+// --------------------------------------------------
+// Constants
+
+// The header of each fragment: [message ID][index][count], followed by the data
+#define SMW_SX1276M0_FRAGMENT_HEADER_SIZE 3
+#define SMW_SX1276M0_FRAGMENT_HEADER_ID 0
+#define SMW_SX1276M0_FRAGMENT_HEADER_INDEX 1
+#define SMW_SX1276M0_FRAGMENT_HEADER_COUNT 2
+
+#define SMW_SX1276M0_FRAGMENT_MAX_COUNT 255
+
+#define SMW_SX1276M0_FRAGMENT_INCOMPLETE 0 // the fragment was stored
+#define SMW_SX1276M0_FRAGMENT_COMPLETE 1 // the fragment completed the message
+#define SMW_SX1276M0_FRAGMENT_INVALID 2 // the fragment was discarded
+
+// -----------------------------------------------------------------
+
+// Reassembler of fragmented messages
+//  NOTE: all the fragments but the last have the same size, so the size
+//        is learned from the first of them (the last can't be stored before)
+//  NOTE: a fragment with a different message ID discards the current message
+class SMW_SX1276M0_Reassembler {
+  public:
+    SMW_SX1276M0_Reassembler(uint8_t *, uint16_t);
+    uint8_t add(const uint8_t *, uint16_t);
+    const uint8_t * data(void);
+    uint8_t id(void);
+    bool isComplete(void);
+    uint16_t length(void);
+    uint8_t missing(void);
+    void reset(void);
+
+  private:
+    uint8_t *_buffer;
+    uint16_t _size;
+    uint16_t _chunk; // the size of the fragments (0 if unknown)
+    uint16_t _length; // the length of the message (valid when complete)
+    uint8_t _id;
+    uint8_t _count; // the number of fragments (0 if no message)
+    uint8_t _received; // the number of fragments received
+    uint8_t _map[(SMW_SX1276M0_FRAGMENT_MAX_COUNT + 7) / 8]; // the fragments received (1 bit each)
+};
+
+// -----------------------------------------------------------------
+
+// Reassembler with the memory reserved at compile time (no heap allocation)
+template <uint16_t N>
+class SMW_SX1276M0_StaticReassembler : public SMW_SX1276M0_Reassembler {
+  public:
+    SMW_SX1276M0_StaticReassembler() : SMW_SX1276M0_Reassembler(_storage, N) {}
+
+  private:
+    uint8_t _storage[N];
+};
+
+// -----------------------------------------------------------------
+
+#endif // SMW_SX1276M0_FRAGMENT_H
@@ -37,7 +37,419 @@ extern "C" {
 }
 
 // --------------------------------------------------
+// Constants (queue)
+
+#define SMW_SX1276M0_QUEUE_GET   0
+#define SMW_SX1276M0_QUEUE_SET   1
+#define SMW_SX1276M0_QUEUE_SEND  2
+#define SMW_SX1276M0_QUEUE_SEND_CONFIRMED  3
+
+// --------------------------------------------------
+// Constants (join manager)
+
+#define SMW_SX1276M0_JOIN_STEP_SEND     0 // waiting to send the request
+#define SMW_SX1276M0_JOIN_STEP_REQUEST  1 // waiting for the response of the request
+#define SMW_SX1276M0_JOIN_STEP_WAIT     2 // waiting for the JOINED event
+#define SMW_SX1276M0_JOIN_STEP_STATUS   3 // waiting for the join status
+#define SMW_SX1276M0_JOIN_STEP_BACKOFF  4 // waiting to retry
+
+// --------------------------------------------------
+// Constants (regional parameters)
+
+#define SMW_SX1276M0_LORAWAN_OVERHEAD  13 // [bytes] (MHDR + FHDR without FOpts + FPort + MIC)
+#define SMW_SX1276M0_CODING_RATE        1 // 4/5
+
+// data rate (uplink) as <bandwidth code | spreading factor> (0 for FSK and 0xFF for undefined)
+#define SMW_SX1276M0_DR(sf, bw)   (((bw) << 4) | (sf))
+#define SMW_SX1276M0_DR_FSK       0x00
+#define SMW_SX1276M0_DR_NONE      0xFF
+#define SMW_SX1276M0_BW_125       0
+#define SMW_SX1276M0_BW_250       1
+#define SMW_SX1276M0_BW_500       2
+
+#define SMW_SX1276M0_UPLINK_DR_UNKNOWN  0xFF // the data rate of the last uplink is unknown
+
+#define SMW_SX1276M0_DR_TABLE_DEFAULT  0 // (EU868 like)
+#define SMW_SX1276M0_DR_TABLE_US915    1
+#define SMW_SX1276M0_DR_TABLE_AU915    2
+
+const uint8_t DATA_RATES[][8] PROGMEM = {
+  { // default (AS923, CN470, CN779, EU433, EU868, IN865, KR920, RU864)
+    SMW_SX1276M0_DR(12, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(11, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(10, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(9, SMW_SX1276M0_BW_125) ,
+    SMW_SX1276M0_DR(8, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(7, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(7, SMW_SX1276M0_BW_250) , SMW_SX1276M0_DR_FSK
+  },
+  { // US915
+    SMW_SX1276M0_DR(10, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(9, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(8, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(7, SMW_SX1276M0_BW_125) ,
+    SMW_SX1276M0_DR(8, SMW_SX1276M0_BW_500) , SMW_SX1276M0_DR_NONE , SMW_SX1276M0_DR_NONE , SMW_SX1276M0_DR_NONE
+  },
+  { // AU915
+    SMW_SX1276M0_DR(12, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(11, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(10, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(9, SMW_SX1276M0_BW_125) ,
+    SMW_SX1276M0_DR(8, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(7, SMW_SX1276M0_BW_125) , SMW_SX1276M0_DR(8, SMW_SX1276M0_BW_500) , SMW_SX1276M0_DR_NONE
+  }
+};
+
+// table of data rates and duty cycle (1/n, 0 for none) of each region (SMW_SX1276M0_REGION_*)
+//  NOTE: the duty cycle is the one of the default channels
+struct RegionParameters {
+  uint8_t data_rates;
+  uint16_t duty_cycle;
+};
+const RegionParameters REGIONS[] PROGMEM = {
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 0 }, // AS923 (listen before talk)
+  { SMW_SX1276M0_DR_TABLE_AU915 , 0 }, // AU915
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 0 }, // CN470
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 1000 }, // CN779 (0.1 %)
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 100 }, // EU433 (1 %)
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 100 }, // EU868 (1 %)
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 0 }, // KR920 (listen before talk)
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 0 }, // IN865
+  { SMW_SX1276M0_DR_TABLE_US915 , 0 }, // US915
+  { SMW_SX1276M0_DR_TABLE_DEFAULT , 100 } // RU864 (1 %)
+};
+static_assert((sizeof(REGIONS) / sizeof(RegionParameters)) == SMW_SX1276M0_REGION_COUNT, "invalid number of regions");
+static_assert((max_payload(SMW_SX1276M0_REGION_EU868, 0) == 51) && (max_payload(SMW_SX1276M0_REGION_US915, 0) == 11), "invalid maximum payload");
+static_assert((max_payload(SMW_SX1276M0_REGION_EU868, 6) == 242) && (max_payload(SMW_SX1276M0_REGION_EU868, 7) == 222), "invalid maximum payload (EU868)");
+static_assert((max_payload(SMW_SX1276M0_REGION_KR920, 5) == 242) && (max_payload(SMW_SX1276M0_REGION_KR920, 6) == 0) && (max_payload(SMW_SX1276M0_REGION_KR920, 7) == 0), "invalid maximum payload (KR920)");
+static_assert((max_payload(SMW_SX1276M0_REGION_CN470, 5) == 242) && (max_payload(SMW_SX1276M0_REGION_CN470, 6) == 0) && (max_payload(SMW_SX1276M0_REGION_CN470, 7) == 0), "invalid maximum payload (CN470)");
+static_assert((max_payload(SMW_SX1276M0_REGION_IN865, 6) == 0) && (max_payload(SMW_SX1276M0_REGION_IN865, 7) == 222), "invalid maximum payload (IN865)");
+static_assert((max_payload(SMW_SX1276M0_REGION_US915, 5) == 0) && (max_payload(SMW_SX1276M0_REGION_AU915, 7) == 0), "invalid maximum payload (US915 and AU915)");
+
+// Get the length of the payload of a text command
+//  @param (command) : the command (CMD_SEND or CMD_SENDB) [char *]
+//         (data)    : the data of the command [char *]
+//  @returns the length of the payload in bytes [uint16_t]
+static uint16_t payload_length(const char *command, const char *data){
+  uint16_t length = strlen(data);
+  if(command == CMD_SENDB){
+    length /= 2; // (hexadecimal)
+  }
+  return length;
+}
+
+// Get a randomized exponential backoff
+//  @param (attempt) : the number of the attempt (from 1) [uint8_t]
+//         (min)     : the backoff of the first attempt [ms] [uint32_t]
+//         (max)     : the maximum backoff [ms] [uint32_t]
+//  @returns the backoff [ms] [uint32_t]
+//  NOTE: the backoff doubles on each attempt (up to the maximum) and half of it is random
+static uint32_t backoff_time(uint8_t attempt, uint32_t min, uint32_t max){
+  uint32_t backoff = min;
+  for(uint8_t i=1 ; (i < attempt) && (backoff < max) ; i++){
+    backoff *= 2;
+  }
+  if(backoff > max){
+    backoff = max;
+  }
+  return (backoff / 2) + random(backoff / 2 + 1);
+}
+
+// --------------------------------------------------
+// Constants (hexadecimal decoder)
+
+#define SMW_SX1276M0_DECODE_OFF    0 // not decoding
+#define SMW_SX1276M0_DECODE_PORT   1 // waiting for the delimitter
+#define SMW_SX1276M0_DECODE_HIGH   2 // waiting for the high nibble
+#define SMW_SX1276M0_DECODE_LOW    3 // waiting for the low nibble
+#define SMW_SX1276M0_DECODE_ERROR  4 // malformed data
+
+// values of the characters from '0' to 'f' (0xFF for invalid characters)
+const uint8_t HEX_VALUES[] PROGMEM = {
+  0 , 1 , 2 , 3 , 4 , 5 , 6 , 7 , 8 , 9 , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF ,
+  0xFF , 10 , 11 , 12 , 13 , 14 , 15 , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF ,
+  0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF ,
+  0xFF , 10 , 11 , 12 , 13 , 14 , 15
+};
+
+// Get the value of an hexadecimal character
+//  @param (c) : the character [uint8_t]
+//  @returns the value (0xFF if the character is not valid) [uint8_t]
+static uint8_t hex_value(uint8_t c){
+  return ((c >= '0') && (c <= 'f')) ? pgm_read_byte(&HEX_VALUES[c - '0']) : 0xFF;
+}
+
+static_assert((SMW_SX1276M0_PORT_HANDLERS_SIZE & (SMW_SX1276M0_PORT_HANDLERS_SIZE - 1)) == 0, "the number of port handlers must be a power of 2");
+static_assert(SMW_SX1276M0_QUEUE_SIZE > 0, "the queue of commands can't be removed");
+
+// --------------------------------------------------
+// Constants (matcher of the unsolicited lines)
+
+// The tokens are matched by a single automaton (Aho-Corasick), built at compile
+// time from the tokens: state 0 is the empty match and the states from
+// <token_offset(token) + 1> to <token_offset(token) + token_size(token)> are the
+// prefixes of each token. Each byte is mapped to a class (0 for the bytes that
+// aren't in any token), so each step is two reads of the tables.
+
+#define SMW_SX1276M0_MATCHER_BYTES  128 // (the tokens are in ASCII)
+
+// Get the length of a string at compile time
+constexpr uint8_t token_length(const char *token){
+  return (*token == CHAR_EOS) ? 0 : (1 + token_length(token + 1));
+}
+
+// Get the length of a token
+//  @param (token) : the token (SMW_SX1276M0_TOKEN_*) [uint8_t]
+//  @returns the length in bytes [uint8_t]
+constexpr uint8_t token_size(uint8_t token){
+  return (token == SMW_SX1276M0_TOKEN_EVENT) ? token_length(RSPNS_EVENT) :
+    (token == SMW_SX1276M0_TOKEN_SLEEP) ? token_length(RSPNS_SLEEP) :
+    (token == SMW_SX1276M0_TOKEN_JOINED) ? token_length(RSPNS_JOINED) :
+    (token == SMW_SX1276M0_TOKEN_RECV) ? token_length(RSPNS_RECV) : sizeof(RSPNS_BOOT);
+}
+
+// Get a byte of a token
+//  @param (token) : the token (SMW_SX1276M0_TOKEN_*) [uint8_t]
+//         (index) : the index of the byte [uint8_t]
+//  @returns the byte [uint8_t]
+constexpr uint8_t token_byte(uint8_t token, uint8_t index){
+  return (token == SMW_SX1276M0_TOKEN_EVENT) ? RSPNS_EVENT[index] :
+    (token == SMW_SX1276M0_TOKEN_SLEEP) ? RSPNS_SLEEP[index] :
+    (token == SMW_SX1276M0_TOKEN_JOINED) ? RSPNS_JOINED[index] :
+    (token == SMW_SX1276M0_TOKEN_RECV) ? RSPNS_RECV[index] : RSPNS_BOOT[index];
+}
+
+// Get the number of states before the states of a token
+constexpr uint8_t token_offset(uint8_t token){
+  return (token == 0) ? 0 : (token_offset(token - 1) + token_size(token - 1));
+}
+
+// Get the token of a state (> 0)
+constexpr uint8_t state_token(uint8_t state, uint8_t token = 0){
+  return (state <= token_offset(token + 1)) ? token : state_token(state, token + 1);
+}
+
+constexpr uint8_t MATCHER_LENGTH = token_offset(SMW_SX1276M0_TOKEN_COUNT); // the total length of the tokens
+
+#define SMW_SX1276M0_MATCHER_LENGTH  MATCHER_LENGTH
+#define SMW_SX1276M0_MATCHER_STATES  (SMW_SX1276M0_MATCHER_LENGTH + 1)
+
+// List of indexes (to build the tables)
+template<uint8_t... I> struct MatcherIndexes {};
+template<uint8_t N, uint8_t... I> struct MatcherSequence : MatcherSequence<N - 1, N - 1, I...> {};
+template<uint8_t... I> struct MatcherSequence<0, I...> { typedef MatcherIndexes<I...> type; };
+
+// The tokens in sequence, with their positions, and the length of the prefix of each state (only at compile time)
+struct MatcherStrings {
+  uint8_t bytes[SMW_SX1276M0_MATCHER_LENGTH];
+  uint8_t offset[SMW_SX1276M0_TOKEN_COUNT + 1];
+  uint8_t depth[SMW_SX1276M0_MATCHER_STATES];
+};
+
+template<uint8_t... P, uint8_t... T, uint8_t... S>
+constexpr MatcherStrings matcher_strings(MatcherIndexes<P...>, MatcherIndexes<T...>, MatcherIndexes<S...>){
+  return { { token_byte(state_token(P + 1), P - token_offset(state_token(P + 1)))... } , { token_offset(T)... } ,
+    { static_cast<uint8_t>((S == 0) ? 0 : (S - token_offset(state_token(S))))... } };
+}
+
+constexpr MatcherStrings MATCHER_STRINGS = matcher_strings(MatcherSequence<SMW_SX1276M0_MATCHER_LENGTH>::type(),
+  MatcherSequence<SMW_SX1276M0_TOKEN_COUNT + 1>::type(), MatcherSequence<SMW_SX1276M0_MATCHER_STATES>::type());
+
+// Get the length of a token (from the table)
+constexpr uint8_t matcher_size(uint8_t token){
+  return MATCHER_STRINGS.offset[token + 1] - MATCHER_STRINGS.offset[token];
+}
+
+// Get a byte of the prefix of a state followed by a new byte (at the index <depth>)
+constexpr uint8_t state_byte(uint8_t state, uint8_t index, uint8_t c){
+  return (index == MATCHER_STRINGS.depth[state]) ? c : MATCHER_STRINGS.bytes[state - MATCHER_STRINGS.depth[state] + index];
+}
+
+// Check if the prefix of a token is the suffix of a state followed by a new byte
+constexpr bool state_suffix(uint8_t state, uint8_t c, uint8_t token, uint8_t length, uint8_t index = 0){
+  return (index == length) ? true :
+    (MATCHER_STRINGS.bytes[MATCHER_STRINGS.offset[token] + index] != state_byte(state, MATCHER_STRINGS.depth[state] + 1 - length + index, c)) ? false :
+    state_suffix(state, c, token, length, index + 1);
+}
+
+// Get the first token with a prefix of a length that is the suffix of a state followed by a new byte
+//  @returns the token (SMW_SX1276M0_TOKEN_COUNT if none) [uint8_t]
+constexpr uint8_t state_suffix_token(uint8_t state, uint8_t c, uint8_t length, uint8_t token = 0){
+  return (token == SMW_SX1276M0_TOKEN_COUNT) ? SMW_SX1276M0_TOKEN_COUNT :
+    ((length <= matcher_size(token)) && state_suffix(state, c, token, length)) ? token :
+    state_suffix_token(state, c, length, token + 1);
+}
+
+// Get the next state: the longest prefix of a token that is a suffix of the state followed by the byte
+//  NOTE: the failure function is already resolved in the transition
+constexpr uint8_t state_next(uint8_t state, uint8_t c, uint8_t length);
+constexpr uint8_t state_next(uint8_t state, uint8_t c, uint8_t length, uint8_t token){
+  return (token != SMW_SX1276M0_TOKEN_COUNT) ? (MATCHER_STRINGS.offset[token] + length) : state_next(state, c, length - 1);
+}
+constexpr uint8_t state_next(uint8_t state, uint8_t c, uint8_t length){
+  return (length == 0) ? 0 : state_next(state, c, length, state_suffix_token(state, c, length));
+}
+
+// Check if a token is a suffix of a state
+constexpr bool state_ends_with(uint8_t state, uint8_t token, uint8_t index = 0){
+  return (MATCHER_STRINGS.depth[state] < matcher_size(token)) ? false :
+    (index == matcher_size(token)) ? true :
+    (MATCHER_STRINGS.bytes[MATCHER_STRINGS.offset[token] + index] != MATCHER_STRINGS.bytes[state - matcher_size(token) + index]) ? false :
+    state_ends_with(state, token, index + 1);
+}
+
+// Get the tokens found in a state (bit mask)
+constexpr uint8_t state_found(uint8_t state, uint8_t token = 0){
+  return (token == SMW_SX1276M0_TOKEN_COUNT) ? 0 :
+    ((state_ends_with(state, token) ? (1 << token) : 0) | state_found(state, token + 1));
+}
+
+// Get the first position of a byte in the tokens (SMW_SX1276M0_MATCHER_LENGTH if none)
+constexpr uint8_t matcher_position(uint8_t c, uint8_t position = 0){
+  return (position == SMW_SX1276M0_MATCHER_LENGTH) ? SMW_SX1276M0_MATCHER_LENGTH :
+    (MATCHER_STRINGS.bytes[position] == c) ? position : matcher_position(c, position + 1);
+}
+
+// Check if a position has the first occurrence of its byte
+constexpr bool matcher_first(uint8_t position){
+  return matcher_position(MATCHER_STRINGS.bytes[position]) == position;
+}
+
+// Get the number of different bytes in the tokens before a position
+constexpr uint8_t matcher_classes(uint8_t position, uint8_t index = 0){
+  return (index == position) ? 0 : ((matcher_first(index) ? 1 : 0) + matcher_classes(position, index + 1));
+}
+
+#define SMW_SX1276M0_MATCHER_CLASSES  (matcher_classes(SMW_SX1276M0_MATCHER_LENGTH) + 1) // (with the class 0)
+
+// Get the class of a byte (0 if not in the tokens)
+constexpr uint8_t matcher_class(uint8_t c){
+  return (matcher_position(c) == SMW_SX1276M0_MATCHER_LENGTH) ? 0 : (matcher_classes(matcher_position(c)) + 1);
+}
+
+// Get the byte of a class (> 0)
+constexpr uint8_t matcher_class_byte(uint8_t character, uint8_t position = 0){
+  return (matcher_first(position) && (matcher_classes(position) + 1 == character)) ? MATCHER_STRINGS.bytes[position] :
+    matcher_class_byte(character, position + 1);
+}
+
+// Check that every byte of the tokens has a class
+constexpr bool matcher_ascii(uint8_t position = 0){
+  return (position == SMW_SX1276M0_MATCHER_LENGTH) ? true :
+    (MATCHER_STRINGS.bytes[position] < SMW_SX1276M0_MATCHER_BYTES) && matcher_ascii(position + 1);
+}
+
+static_assert(SMW_SX1276M0_TOKEN_COUNT <= 8, "the tokens found are stored in a byte");
+static_assert(SMW_SX1276M0_MATCHER_STATES <= 0xFF, "too many states in the matcher");
+static_assert(matcher_ascii(), "the tokens must be in ASCII");
+
+// The byte of each class (only at compile time)
+struct MatcherClassBytes {
+  uint8_t bytes[SMW_SX1276M0_MATCHER_CLASSES];
+};
+
+template<uint8_t... K>
+constexpr MatcherClassBytes matcher_class_bytes(MatcherIndexes<K...>){
+  return { { static_cast<uint8_t>((K == 0) ? 0 : matcher_class_byte(K))... } };
+}
+
+constexpr MatcherClassBytes MATCHER_CLASS_BYTES = matcher_class_bytes(MatcherSequence<SMW_SX1276M0_MATCHER_CLASSES>::type());
+
+// Get the transition of a state with a class
+constexpr uint8_t matcher_next(uint8_t state, uint8_t character){
+  return (character == 0) ? 0 : state_next(state, MATCHER_CLASS_BYTES.bytes[character], MATCHER_STRINGS.depth[state] + 1);
+}
+
+// The tables of the automaton
+struct MatcherRow {
+  uint8_t next[SMW_SX1276M0_MATCHER_CLASSES];
+};
+
+struct MatcherTables {
+  uint8_t classes[SMW_SX1276M0_MATCHER_BYTES]; // the class of each byte
+  MatcherRow states[SMW_SX1276M0_MATCHER_STATES]; // the next state of each state and class
+  uint8_t found[SMW_SX1276M0_MATCHER_STATES]; // the tokens found in each state (bit mask)
+};
+
+template<uint8_t... K>
+constexpr MatcherRow matcher_row(uint8_t state, MatcherIndexes<K...>){
+  return { { matcher_next(state, K)... } };
+}
+
+template<uint8_t... C, uint8_t... S, uint8_t... K>
+constexpr MatcherTables matcher_tables(MatcherIndexes<C...>, MatcherIndexes<S...>, MatcherIndexes<K...> classes){
+  return { { matcher_class(C)... } , { matcher_row(S, classes)... } , { state_found(S)... } };
+}
+
+const MatcherTables MATCHER PROGMEM = matcher_tables(MatcherSequence<SMW_SX1276M0_MATCHER_BYTES>::type(),
+  MatcherSequence<SMW_SX1276M0_MATCHER_STATES>::type(), MatcherSequence<SMW_SX1276M0_MATCHER_CLASSES>::type());
+
+static_assert(state_found(MATCHER_STRINGS.offset[SMW_SX1276M0_TOKEN_RECV + 1]) == (1 << SMW_SX1276M0_TOKEN_RECV), "invalid matcher");
+static_assert(matcher_next(MATCHER_STRINGS.offset[SMW_SX1276M0_TOKEN_EVENT] + 1, matcher_class('[')) == (MATCHER_STRINGS.offset[SMW_SX1276M0_TOKEN_EVENT] + 1), "invalid matcher");
+
+// --------------------------------------------------
+// Constants (shadow of the configuration)
+
+struct ShadowKey {
+  uint8_t offset; // the position in <_shadow_keys>
+  uint8_t size; // the size in bytes (0 if not a key)
+};
+
+// position of the keys in the shadow (indexed by SMW_SX1276M0_SHADOW_*)
+//  NOTE: the keys are stored in binary (half of the characters)
+const ShadowKey SHADOW_KEYS[] PROGMEM = {
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_ADR
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_AJOIN
+  { 0 , SMW_SX1276M0_SIZE_APPEUI / 2 }, // SMW_SX1276M0_SHADOW_APPEUI
+  { 8 , SMW_SX1276M0_SIZE_APPKEY / 2 }, // SMW_SX1276M0_SHADOW_APPKEY
+  { 24 , SMW_SX1276M0_SIZE_APPSKEY / 2 }, // SMW_SX1276M0_SHADOW_APPSKEY
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_CONFIRMATION
+  { 40 , SMW_SX1276M0_SIZE_DEVADDR / 2 }, // SMW_SX1276M0_SHADOW_DEVADDR
+  { 44 , SMW_SX1276M0_SIZE_DEVEUI / 2 }, // SMW_SX1276M0_SHADOW_DEVEUI
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_DR
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_ECHO
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_JOIN_MODE
+  { 52 , SMW_SX1276M0_SIZE_NWKSKEY / 2 }, // SMW_SX1276M0_SHADOW_NWKSKEY
+  { 68 , SMW_SX1276M0_SIZE_DEVADDR / 2 }, // SMW_SX1276M0_SHADOW_P2P_DEVADDR
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_P2P_WORD
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_REGION
+  { 0 , 0 }, // SMW_SX1276M0_SHADOW_RETRIES
+  { 0 , 0 } // SMW_SX1276M0_SHADOW_TXP
+};
+static_assert((sizeof(SHADOW_KEYS) / sizeof(ShadowKey)) == SMW_SX1276M0_SHADOW_COUNT, "invalid number of keys");
+static_assert((68 + (SMW_SX1276M0_SIZE_DEVADDR / 2)) == SMW_SX1276M0_SHADOW_KEYS_SIZE, "invalid size of the keys");
+
+// Decode a key for the shadow
+//  @param (index) : the index of the key (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//         (key)   : the key (hexadecimal) [char *]
+//         (data)  : the array to store the key [uint8_t *]
+//  @returns the size of the key in bytes (0 if the key is not complete) [uint8_t]
+//  NOTE: only the hexadecimal characters are used (in upper or lower case)
+static uint8_t decode_key(uint8_t index, const char *key, uint8_t *data){
+  uint8_t size = pgm_read_byte(&SHADOW_KEYS[index].size);
+  uint8_t count = 0; // the number of characters decoded
+  for(uint8_t i=0 ; (i < (2 * size)) && (key[i] != CHAR_EOS) ; i++){
+    uint8_t value = hex_value(key[i]);
+    if(value == 0xFF){
+      continue; // not hexadecimal
+    }
+    if(count % 2){
+      data[count / 2] |= value;
+    } else {
+      data[count / 2] = value << 4;
+    }
+    count++;
+  }
+  return (count == (2 * size)) ? size : 0;
+}
+
+// order of the parameters in <apply()>
+//  NOTE: the parameters that reset the module come first, because the reset invalidates the shadow
+//  NOTE: the keys are set after the join mode and the DR after the ADR
+const uint8_t APPLY_ORDER[] PROGMEM = {
+  SMW_SX1276M0_SHADOW_JOIN_MODE , SMW_SX1276M0_SHADOW_REGION , // reset the module
+  SMW_SX1276M0_SHADOW_DEVEUI , SMW_SX1276M0_SHADOW_APPEUI , SMW_SX1276M0_SHADOW_APPKEY ,
+  SMW_SX1276M0_SHADOW_DEVADDR , SMW_SX1276M0_SHADOW_NWKSKEY , SMW_SX1276M0_SHADOW_APPSKEY ,
+  SMW_SX1276M0_SHADOW_ADR , SMW_SX1276M0_SHADOW_DR , SMW_SX1276M0_SHADOW_TXP ,
+  SMW_SX1276M0_SHADOW_CONFIRMATION , SMW_SX1276M0_SHADOW_RETRIES , SMW_SX1276M0_SHADOW_ECHO ,
+  SMW_SX1276M0_SHADOW_P2P_DEVADDR , SMW_SX1276M0_SHADOW_P2P_WORD ,
+  SMW_SX1276M0_SHADOW_AJOIN // last, so the join uses the new configuration
+};
+static_assert(sizeof(APPLY_ORDER) == SMW_SX1276M0_SHADOW_COUNT, "invalid order of the parameters");
+#define SMW_SX1276M0_APPLY_RESETS  2 // the number of parameters that reset the module
+
 // --------------------------------------------------
+// --------------------------------------------------
+
+#if SMW_SX1276M0_BUFFER_SIZE > 0
 
 // Default constructor
 //  @param (stream) : the stream to send the data to [Stream *]
@@ -49,25 +461,245 @@ SMW_SX1276M0::SMW_SX1276M0(Stream &stream) :
 
 // --------------------------------------------------
 
-// Complete constructor
+// Constructor
 //  @param (stream)    : the stream to send the data to [Stream *]
 //         (pin_reset) : the pin to reset the module [int16_t]
 SMW_SX1276M0::SMW_SX1276M0(Stream &stream, int16_t pin_reset) :
+  SMW_SX1276M0(stream, pin_reset, _buffer_internal)
+  {
+  // nothing to do here
+}
+
+#endif
+
+// --------------------------------------------------
+
+// Complete constructor
+//  @param (stream)    : the stream to send the data to [Stream *]
+//         (pin_reset) : the pin to reset the module [int16_t]
+//         (buffer)    : the buffer to store the received data [Buffer (&)]
+//  NOTE: the buffer must outlive the object and should be large enough for
+//        the largest expected message (2 characters per byte in a RECVB response)
+//  NOTE: the internal buffer (SMW_SX1276M0_BUFFER_SIZE bytes) is not used, so
+//        define SMW_SX1276M0_BUFFER_SIZE as 0 to remove it when all the objects
+//        are created with an external buffer (the other constructors are removed)
+SMW_SX1276M0::SMW_SX1276M0(Stream &stream, int16_t pin_reset, Buffer &buffer) :
   event_listener(nullptr),
+  response_listener(nullptr),
   _stream(&stream),
   _pin_reset(pin_reset),
-  _buffer(SMW_SX1276M0_BUFFER_SIZE),
+  _buffer(buffer),
+  _busy(false),
+  _busy_async(false),
+  _command_start(0),
+  _command_timeout(0),
+  _last_response(CommandResponse::ERROR),
+  _response_status(0),
+  _queue_head(0),
+  _queue_count(0),
+  _queue_active(false),
+  _schedule_count(0),
+  _schedule_dropped(0),
+  _overflow(0),
+  _event_head(0),
+  _event_count(0),
+  _events_dropped(0),
+  _event_time(0),
+  _response_line_start(true),
+  _subscriber_count(0),
+  _subscriber_calls(0),
+  _port_handler_count(0),
+  _default_handler(nullptr),
+  _default_context(nullptr),
+  _decode_data(nullptr),
+  _decode_size(0),
+  _decode_length(0),
+  _decode_state(SMW_SX1276M0_DECODE_OFF),
+  _decode_high(0),
+  _token_state(0),
+  _tokens(0),
+  _token_recv_end(0),
+  _shadow_valid(0),
   _connected(false),
   _reset(false),
-  _sleeping(false)
+  _sleeping(false),
+  _response_mode(SMW_SX1276M0_RESPONSE_MODE_COMPLETION),
+  _response_time(0),
+  _boot_time(0),
+  _join_state(JoinState::IDLE),
+  _join_step(SMW_SX1276M0_JOIN_STEP_SEND),
+  _join_attempts(0),
+  _join_start(0),
+  _join_deadline(0),
+  _join_time(0),
+  _join_backoff(0),
+  _uplink_gate(true),
+  _uplink_pending(false),
+  _uplink_length(0),
+  _uplink_start(0),
+  _uplink_off(0),
+  _uplink_dr(SMW_SX1276M0_UPLINK_DR_UNKNOWN),
+  _confirmed_count(0),
+  _confirmed_last{ nullptr , 0 , ConfirmedState::PENDING , 0 , 0 },
+  _confirmed_acked(0),
+  _confirmed_failed(0),
+  _fragment_id(0)
   {
 #ifdef SMW_SX1276M0_DEBUG
     _stream_debug = nullptr;
 #endif
+  _reset_line(); // reset the matcher
+#if SMW_SX1276M0_PORT_HANDLERS_SIZE > 0
+  for(uint8_t i=0 ; i < SMW_SX1276M0_PORT_HANDLERS_SIZE ; i++){
+    _port_handlers[i] = { 0 , nullptr , nullptr }; // empty
+  }
+#endif
+}
+
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Apply a configuration profile
+//  @param (config) : the configuration to apply [SMW_SX1276M0_Config (&)]
+//         (report) : the result of each parameter [SMW_SX1276M0_ConfigReport (&)]
+//  @returns OK if all the parameters were applied or the response of the first failure [CommandResponse]
+//  NOTE: the current state is read once (fast) and only the parameters that differ are set
+//  NOTE: the failures don't stop the other parameters
+CommandResponse SMW_SX1276M0::apply(const SMW_SX1276M0_Config &config, SMW_SX1276M0_ConfigReport &report){
+  CommandResponse res = CommandResponse::OK;
+  uint32_t value;
+  char key[SMW_SX1276M0_SIZE_PARAMETER + 1];
+
+  for(uint8_t i=0 ; i < SMW_SX1276M0_SHADOW_COUNT ; i++){
+    report.status[i] = SMW_SX1276M0_APPLY_SKIPPED;
+  }
+
+  for(uint8_t i=0 ; i < SMW_SX1276M0_SHADOW_COUNT ; i++){
+    // read the state of the other parameters in one pass (after the resets)
+    if(i == SMW_SX1276M0_APPLY_RESETS){
+      for(uint8_t j=i ; j < SMW_SX1276M0_SHADOW_COUNT ; j++){
+        uint8_t index = pgm_read_byte(&APPLY_ORDER[j]);
+        if(_apply_value(config, index, value, key)){
+          _apply_read(index);
+        }
+      }
+    }
+
+    uint8_t index = pgm_read_byte(&APPLY_ORDER[i]);
+    if(!_apply_value(config, index, value, key)){
+      continue; // not in the configuration
+    }
+    if(i < SMW_SX1276M0_APPLY_RESETS){
+      _apply_read(index);
+    }
+
+    // check the current value
+    bool unchanged = (pgm_read_byte(&SHADOW_KEYS[index].size) > 0) ? _shadow_check(index, key) : _shadow_check(index, value);
+    if(unchanged){
+      report.status[index] = SMW_SX1276M0_APPLY_UNCHANGED;
+      continue;
+    }
+
+    // set the new value
+    CommandResponse temp = _apply_write(config, index);
+    if(temp == CommandResponse::OK){
+      report.status[index] = SMW_SX1276M0_APPLY_SET;
+    } else {
+      report.status[index] = SMW_SX1276M0_APPLY_FAILED;
+      if(res == CommandResponse::OK){
+        res = temp; // store the first failure
+      }
+    }
+  }
+
+  return res;
+}
+
+// --------------------------------------------------
+
+// Queue a query to the module
+//  @param (command)  : the command to send (CMD_*) [char *]
+//         (callback) : the function to call with the result [CommandCallback] (default: nullptr)
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns true if the command was queued [bool]
+//  NOTE: the commands are sent by <poll()>, one right after the other
+bool SMW_SX1276M0::enqueue_get(const char *command, CommandCallback callback, void *context){
+  return _enqueue(SMW_SX1276M0_QUEUE_GET, command, nullptr, 0, nullptr, callback, context);
+}
+
+// --------------------------------------------------
+
+// Queue a text message
+//  @param (port)     : the application port [uint8_t]
+//         (data)     : the text data to send [char *]
+//         (callback) : the function to call with the result [CommandCallback] (default: nullptr)
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns true if the message was queued [bool]
+//  NOTE: the data is not copied, so it must remain valid until the callback
+bool SMW_SX1276M0::enqueue_sendT(uint8_t port, const char *data, CommandCallback callback, void *context){
+  return _enqueue(SMW_SX1276M0_QUEUE_SEND, CMD_SEND, nullptr, port, data, callback, context);
+}
+
+// --------------------------------------------------
+
+// Queue an hexadecimal message
+//  @param (port)     : the application port [uint8_t]
+//         (data)     : the hexadecimal data to send [char *]
+//         (callback) : the function to call with the result [CommandCallback] (default: nullptr)
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns true if the message was queued [bool]
+//  NOTE: the data is not copied, so it must remain valid until the callback
+bool SMW_SX1276M0::enqueue_sendX(uint8_t port, const char *data, CommandCallback callback, void *context){
+  return _enqueue(SMW_SX1276M0_QUEUE_SEND, CMD_SENDB, nullptr, port, data, callback, context);
+}
+
+// --------------------------------------------------
+
+// Queue a configuration to the module
+//  @param (command)   : the command to send (CMD_*) [char *]
+//         (parameter) : the value to set, as sent to the module [char *]
+//         (callback)  : the function to call with the result [CommandCallback] (default: nullptr)
+//         (context)   : the context for the callback [void *] (default: nullptr)
+//  @returns true if the command was queued [bool]
+//  NOTE: the parameter is copied, but it is not validated as in the <set_*()> methods
+//  NOTE: the commands that reset the module (CMD_NJM and CMD_REGION) cannot be queued
+//  NOTE: the shadow of the configuration is invalidated
+bool SMW_SX1276M0::enqueue_set(const char *command, const char *parameter, CommandCallback callback, void *context){
+  if(!command || !parameter || (strcmp(command, CMD_NJM) == 0) || (strcmp(command, CMD_REGION) == 0)){
+    return false;
+  }
+  if(strlen(parameter) > SMW_SX1276M0_SIZE_PARAMETER){
+    return false;
+  }
+  invalidateShadow(); // the value is not validated, so it can't be stored
+  return _enqueue(SMW_SX1276M0_QUEUE_SET, command, parameter, 0, nullptr, callback, context);
 }
 
+// --------------------------------------------------
+
+// Send a text message and track its acknowledgement
+//  @param (port)    : the application port [uint8_t]
+//         (data)    : the text data to send [char *]
+//         (retries) : the maximum number of retries [uint8_t] (default: SMW_SX1276M0_CONFIRMED_RETRIES)
+//  @returns true if the message was added to the tracker [bool]
+//  NOTE: see <_confirmed_process()>
+bool SMW_SX1276M0::confirm_sendT(uint8_t port, const char *data, uint8_t retries){
+  return _confirmed_add(CMD_SEND, port, data, retries);
+}
 
 // --------------------------------------------------
+
+// Send an hexadecimal message and track its acknowledgement
+//  @param (port)    : the application port [uint8_t]
+//         (data)    : the hexadecimal data to send [char *]
+//         (retries) : the maximum number of retries [uint8_t] (default: SMW_SX1276M0_CONFIRMED_RETRIES)
+//  @returns true if the message was added to the tracker [bool]
+//  NOTE: see <_confirmed_process()>
+bool SMW_SX1276M0::confirm_sendX(uint8_t port, const char *data, uint8_t retries){
+  return _confirmed_add(CMD_SENDB, port, data, retries);
+}
+
 // --------------------------------------------------
 
 // Flush the buffered data in the stream
@@ -75,6 +707,38 @@ void SMW_SX1276M0::flush(void){
   while(_stream->available()){
     _stream->read();
   }
+  _reset_line(); // discard the partial line
+}
+
+// --------------------------------------------------
+
+// Send the oldest message of a store-and-forward log
+//  @param (log) : the log [UplinkLog (&)]
+//  @returns OK if a message was sent, ERROR if not connected or if the log is empty,
+//           or the response of the send [CommandResponse]
+//  NOTE: the message is removed from the log if the send succeeds (OK) or if it
+//        is longer than the current maximum payload (TOO_LONG, counted in
+//        <UplinkLog::rejected()>), so the loop until the log is empty ends
+//  NOTE: with any other response the message is kept, to be sent again in order
+CommandResponse SMW_SX1276M0::forward(UplinkLog &log){
+  if(!_connected || (log.available() == 0)){
+    return CommandResponse::ERROR;
+  }
+
+  uint8_t port;
+  uint8_t length;
+  uint8_t data[UPLINK_LOG_DATA_SIZE]; // (the maximum data size of a log)
+  if(!log.peek(port, data, length)){
+    return CommandResponse::ERROR;
+  }
+
+  CommandResponse res = sendX(port, data, length);
+  if(res == CommandResponse::OK){
+    log.pop();
+  } else if(res == CommandResponse::TOO_LONG){
+    log.reject(); // (it would never be sent)
+  }
+  return res;
 }
 
 // --------------------------------------------------
@@ -94,6 +758,7 @@ CommandResponse SMW_SX1276M0::get_ADR(uint8_t (&adr)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       adr = _buffer.read() - '0';
+      _shadow_update(SMW_SX1276M0_SHADOW_ADR, adr, res);
     }
   }
 
@@ -117,6 +782,7 @@ CommandResponse SMW_SX1276M0::get_AJoin(uint8_t (&ajoin)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       ajoin = _buffer.read() - '0';
+      _shadow_update(SMW_SX1276M0_SHADOW_AJOIN, ajoin, res);
     }
   }
 
@@ -161,11 +827,12 @@ CommandResponse SMW_SX1276M0::get_AppEUI(char (&appeui)[SMW_SX1276M0_SIZE_APPEUI
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_APPEUI){
       appeui[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(appeui));
+    _shadow_update(SMW_SX1276M0_SHADOW_APPEUI, appeui, res);
   }
 
   return res;
@@ -186,11 +853,12 @@ CommandResponse SMW_SX1276M0::get_AppKey(char (&appkey)[SMW_SX1276M0_SIZE_APPKEY
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_APPKEY){
       appkey[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(appkey));
+    _shadow_update(SMW_SX1276M0_SHADOW_APPKEY, appkey, res);
   }
 
   return res;
@@ -211,11 +879,12 @@ CommandResponse SMW_SX1276M0::get_AppSKey(char (&appskey)[SMW_SX1276M0_SIZE_APPS
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_APPSKEY){
       appskey[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(appskey));
+    _shadow_update(SMW_SX1276M0_SHADOW_APPSKEY, appskey, res);
   }
 
   return res;
@@ -223,6 +892,34 @@ CommandResponse SMW_SX1276M0::get_AppSKey(char (&appskey)[SMW_SX1276M0_SIZE_APPS
 
 // --------------------------------------------------
 
+// Get the duration of the last reset
+//  @returns the time between the reset command and the module being ready in miliseconds [uint32_t]
+//  NOTE: the value is 0 if the last reset failed
+uint32_t SMW_SX1276M0::get_BootTime(void){
+  return _boot_time;
+}
+
+// --------------------------------------------------
+
+// Get the number of events that were discarded because the queue was full
+//  @returns the number of events [uint32_t]
+//  NOTE: use a larger SMW_SX1276M0_EVENT_QUEUE_SIZE if this value increases
+uint32_t SMW_SX1276M0::get_EventsDropped(void){
+  return _events_dropped;
+}
+
+// --------------------------------------------------
+
+// Get the time of the event being called
+//  @returns the time the event was received [ms] (<millis()>) [uint32_t]
+//  NOTE: the events received during a command are called later (by <poll()>
+//        or <listen()>), so this time can be earlier than the call
+uint32_t SMW_SX1276M0::get_EventTime(void){
+  return _event_time;
+}
+
+// --------------------------------------------------
+
 // Get the uplink confirmation mode
 //  @param (mode) : the variable to store the result [uint8_t (&)]
 //  @returns the type of the response [CommandResponse]
@@ -238,6 +935,7 @@ CommandResponse SMW_SX1276M0::get_Confirmation(uint8_t (&mode)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       mode = _buffer.read() - '0';
+      _shadow_update(SMW_SX1276M0_SHADOW_CONFIRMATION, mode, res);
     }
   }
 
@@ -246,6 +944,30 @@ CommandResponse SMW_SX1276M0::get_Confirmation(uint8_t (&mode)){
 
 // --------------------------------------------------
 
+// Get the number of confirmed messages in a state
+//  @param (state) : the state [ConfirmedState]
+//  @returns the number of messages acknowledged or failed since the start, or pending [uint32_t]
+//  NOTE: the delivery rate is <ACKED / (ACKED + FAILED)>
+uint32_t SMW_SX1276M0::get_ConfirmedCount(ConfirmedState state){
+  if(state == ConfirmedState::ACKED){
+    return _confirmed_acked;
+  } else if(state == ConfirmedState::FAILED){
+    return _confirmed_failed;
+  }
+  return _confirmed_count;
+}
+
+// --------------------------------------------------
+
+// Get the report of the last confirmed message completed
+//  @param (report) : the variable to store the report [ConfirmedReport (&)]
+//  NOTE: use it in the ACKNOWLEDGED and NOT_ACKNOWLEDGED events
+void SMW_SX1276M0::get_ConfirmedReport(ConfirmedReport &report){
+  report = _confirmed_last;
+}
+
+// --------------------------------------------------
+
 // Get the Device Address
 //  @param (devaddr) : the array to store the result [char[n]]
 //  @returns the type of the response [CommandResponse]
@@ -259,11 +981,12 @@ CommandResponse SMW_SX1276M0::get_DevAddr(char (&devaddr)[SMW_SX1276M0_SIZE_DEVA
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_DEVADDR){
       devaddr[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(devaddr));
+    _shadow_update(SMW_SX1276M0_SHADOW_DEVADDR, devaddr, res);
   }
 
   return res;
@@ -284,11 +1007,12 @@ CommandResponse SMW_SX1276M0::get_DevEUI(char (&deveui)[SMW_SX1276M0_SIZE_DEVEUI
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_DEVEUI){
       deveui[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(deveui));
+    _shadow_update(SMW_SX1276M0_SHADOW_DEVEUI, deveui, res);
   }
 
   return res;
@@ -311,6 +1035,7 @@ CommandResponse SMW_SX1276M0::get_DR(uint8_t (&dr)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       dr = _buffer.read() - '0';
+      _shadow_update(SMW_SX1276M0_SHADOW_DR, dr, res);
     }
   }
 
@@ -334,6 +1059,7 @@ CommandResponse SMW_SX1276M0::get_Echo(uint8_t (&echo)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       echo = _buffer.read() - '0';
+      _shadow_update(SMW_SX1276M0_SHADOW_ECHO, echo, res);
     }
   }
 
@@ -350,6 +1076,14 @@ void SMW_SX1276M0::get_buffer(Buffer (&buffer)){
 
 // --------------------------------------------------
 
+// Get the number of join requests sent by <join_async()>
+//  @returns the number of attempts [uint8_t]
+uint8_t SMW_SX1276M0::get_JoinAttempts(void){
+  return _join_attempts;
+}
+
+// --------------------------------------------------
+
 // Get the Join Mode
 //  @param (mode) : the variable to store the result [uint8_t (&)]
 //  @returns the type of the response [CommandResponse]
@@ -365,6 +1099,7 @@ CommandResponse SMW_SX1276M0::get_JoinMode(uint8_t (&mode)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       mode = _buffer.read() - '0';
+      _shadow_update(SMW_SX1276M0_SHADOW_JOIN_MODE, mode, res);
     }
   }
 
@@ -373,6 +1108,15 @@ CommandResponse SMW_SX1276M0::get_JoinMode(uint8_t (&mode)){
 
 // --------------------------------------------------
 
+// Get the state of the join started with <join_async()>
+//  @returns the state [JoinState]
+//  NOTE: the state is updated in <poll()>
+JoinState SMW_SX1276M0::get_JoinState(void){
+  return _join_state;
+}
+
+// --------------------------------------------------
+
 // Get the Join Status
 //  @param (status) : the variable to store the result [uint8_t (&)]
 //  @returns the type of the response [CommandResponse]
@@ -399,6 +1143,15 @@ CommandResponse SMW_SX1276M0::get_JoinStatus(uint8_t (&status)){
 
 // --------------------------------------------------
 
+// Get the response of the last command
+//  @returns the type of the response [CommandResponse]
+//  NOTE: useful to check the result of an asynchronous command after <isBusy()> returns false
+CommandResponse SMW_SX1276M0::get_LastResponse(void){
+  return _last_response;
+}
+
+// --------------------------------------------------
+
 // Get number of uplink retries (when the confirmation mode is on)
 //  @param (num_retries) : the variable to store the result [uint8_t (&)]
 //  @returns the type of the response [CommandResponse]
@@ -414,6 +1167,7 @@ CommandResponse SMW_SX1276M0::get_NumberOfRetries(uint8_t (&num_retries)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       num_retries = _buffer.read() - '0'; // (1 to 8)
+      _shadow_update(SMW_SX1276M0_SHADOW_RETRIES, num_retries, res);
     }
   }
 
@@ -435,11 +1189,12 @@ CommandResponse SMW_SX1276M0::get_NwkSKey(char (&nwkskey)[SMW_SX1276M0_SIZE_NWKS
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_NWKSKEY){
       nwkskey[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(nwkskey));
+    _shadow_update(SMW_SX1276M0_SHADOW_NWKSKEY, nwkskey, res);
   }
 
   return res;
@@ -447,6 +1202,15 @@ CommandResponse SMW_SX1276M0::get_NwkSKey(char (&nwkskey)[SMW_SX1276M0_SIZE_NWKS
 
 // --------------------------------------------------
 
+// Get the quantity of bytes discarded because the buffers were full
+//  @returns the total quantity of bytes since the start [uint32_t]
+//  NOTE: use the complete constructor to set a larger buffer if this value increases
+uint32_t SMW_SX1276M0::get_Overflow(void){
+  return _overflow;
+}
+
+// --------------------------------------------------
+
 // Get the P2P Device Address
 //  @param (devaddr) : the array to store the result [char[n]]
 //  @returns the type of the response [CommandResponse]
@@ -460,11 +1224,12 @@ CommandResponse SMW_SX1276M0::get_P2P_DevAddr(char (&devaddr)[SMW_SX1276M0_SIZE_
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_DEVADDR){
       devaddr[length] = CHAR_EOS;
     }
     _buffer.copy(reinterpret_cast<uint8_t *>(devaddr));
+    _shadow_update(SMW_SX1276M0_SHADOW_P2P_DEVADDR, devaddr, res);
   }
 
   return res;
@@ -485,14 +1250,17 @@ CommandResponse SMW_SX1276M0::get_P2P_SyncWord(uint8_t (&sync_word)){
 #endif
 
   if(res == CommandResponse::OK){
-    char buffer_value[4] = { '0' }; // default value is 0
+    char buffer_value[4] = { CHAR_EOS };
     uint8_t index = 0;
     while(_buffer.available()){
       char c = _buffer.read();
-      if(isdigit(c)){
+      if(isdigit(c) && (index < (sizeof(buffer_value) - 1))){
         buffer_value[index++] = c;
       }
+    }
+    if(index > 0){
       sync_word = uint8_t(atoi(buffer_value)); // (1 to 255)
+      _shadow_update(SMW_SX1276M0_SHADOW_P2P_WORD, sync_word, res); // (only with a value)
     }
   }
 
@@ -501,6 +1269,30 @@ CommandResponse SMW_SX1276M0::get_P2P_SyncWord(uint8_t (&sync_word)){
 
 // --------------------------------------------------
 
+// Get the number of queued commands
+//  @returns the number of commands waiting or being processed [uint8_t]
+uint8_t SMW_SX1276M0::get_QueueCount(void){
+  return _queue_count;
+}
+
+// --------------------------------------------------
+
+// Get the number of scheduled messages
+//  @returns the number of messages waiting to be queued [uint8_t]
+uint8_t SMW_SX1276M0::get_ScheduleCount(void){
+  return _schedule_count;
+}
+
+// --------------------------------------------------
+
+// Get the number of scheduled messages that were dropped
+//  @returns the number of messages [uint32_t]
+uint32_t SMW_SX1276M0::get_ScheduleDropped(void){
+  return _schedule_dropped;
+}
+
+// --------------------------------------------------
+
 // Get the LoRaWAN Region
 //  @param (region) : the variable to store the result [uint8_t (&)]
 //  @returns the type of the response [CommandResponse]
@@ -516,6 +1308,7 @@ CommandResponse SMW_SX1276M0::get_Region(uint8_t (&region)){
   if(res == CommandResponse::OK){
     if(_buffer.available()){
       region = _buffer.read() - '0'; // (0 to 9)
+      _shadow_update(SMW_SX1276M0_SHADOW_REGION, region, res);
     }
   }
 
@@ -524,6 +1317,15 @@ CommandResponse SMW_SX1276M0::get_Region(uint8_t (&region)){
 
 // --------------------------------------------------
 
+// Get the duration of the last command response
+//  @returns the time between the start of the reading and its end in miliseconds [uint32_t]
+//  NOTE: in the timeout mode, the full timeout is always measured
+uint32_t SMW_SX1276M0::get_ResponseTime(void){
+  return _response_time;
+}
+
+// --------------------------------------------------
+
 // Get the RSSI of the last received data
 //  @param (rssi) : the variable to store the result [double (&)]
 //  @returns the type of the response [CommandResponse]
@@ -595,14 +1397,17 @@ CommandResponse SMW_SX1276M0::get_TXPower(uint8_t (&tx_power)){
 #endif
 
   if(res == CommandResponse::OK){
-    char buffer_value[3] = { '0' }; // default value is 0
+    char buffer_value[3] = { CHAR_EOS };
     uint8_t index = 0;
     while(_buffer.available()){
       char c = _buffer.read();
-      if(isdigit(c)){
+      if(isdigit(c) && (index < (sizeof(buffer_value) - 1))){
         buffer_value[index++] = c;
       }
+    }
+    if(index > 0){
       tx_power = uint8_t(atoi(buffer_value)); // (0 to 10)
+      _shadow_update(SMW_SX1276M0_SHADOW_TXP, tx_power, res); // (only with a value)
     }
   }
 
@@ -611,6 +1416,35 @@ CommandResponse SMW_SX1276M0::get_TXPower(uint8_t (&tx_power)){
 
 // --------------------------------------------------
 
+// Get the time on air of an uplink with the current region and data rate
+//  @param (length) : the length of the application payload in bytes [uint16_t]
+//  @returns the time on air in microseconds (0 if the region or the data rate is unknown) [uint32_t]
+//  NOTE: the region and the data rate are known after being read or set (see <apply()>)
+uint32_t SMW_SX1276M0::get_TimeOnAir(uint16_t length){
+  uint8_t sf;
+  uint16_t bandwidth;
+  if(!_uplink_datarate(sf, bandwidth)){
+    return 0;
+  }
+  return time_on_air(sf, bandwidth, SMW_SX1276M0_CODING_RATE, length + SMW_SX1276M0_LORAWAN_OVERHEAD);
+}
+
+// --------------------------------------------------
+
+// Get the time until the next uplink is allowed by the duty cycle
+//  @returns the time to wait in miliseconds (0 if allowed) [uint32_t]
+//  NOTE: the duty cycle is tracked only for the uplinks with a known region and data rate
+uint32_t SMW_SX1276M0::get_UplinkWait(void){
+  uint32_t elapsed = millis() - _uplink_start;
+  if(elapsed >= _uplink_off){
+    _uplink_off = 0; // reset (prevents the overflow of <millis()>)
+    return 0;
+  }
+  return _uplink_off - elapsed;
+}
+
+// --------------------------------------------------
+
 // Get the Version
 //  @param (version) : the array to store the result [char[n]]
 //  @returns the type of the response [CommandResponse]
@@ -624,7 +1458,7 @@ CommandResponse SMW_SX1276M0::get_Version(char (&version)[SMW_SX1276M0_SIZE_VERS
 #endif
 
   if(res == CommandResponse::OK){
-    uint8_t length = _buffer.available();
+    uint16_t length = _buffer.available();
     if(length < SMW_SX1276M0_SIZE_VERSION){
       version[length] = CHAR_EOS;
     }
@@ -636,6 +1470,16 @@ CommandResponse SMW_SX1276M0::get_Version(char (&version)[SMW_SX1276M0_SIZE_VERS
 
 // --------------------------------------------------
 
+// Invalidate the shadow of the configuration
+//  NOTE: the next <set_*()> calls will always be sent to the module
+//  NOTE: use this if the module can be configured by other means
+void SMW_SX1276M0::invalidateShadow(void){
+  _shadow_valid = 0;
+  _uplink_dr = SMW_SX1276M0_UPLINK_DR_UNKNOWN;
+}
+
+// --------------------------------------------------
+
 // Join the network
 //  NOTE: the confirmation is asynchronous (<listen()>)
 void SMW_SX1276M0::join(void){
@@ -644,6 +1488,36 @@ void SMW_SX1276M0::join(void){
 
 // --------------------------------------------------
 
+// Join the network without blocking
+//  @param (deadline) : the maximum time for all the attempts in miliseconds [uint32_t] (default: SMW_SX1276M0_TIMEOUT_JOIN)
+//  @returns false if the module is already joined or joining [bool]
+//  NOTE: <poll()> must be called to send the requests and to update the state (<get_JoinState()>)
+//  NOTE: the requests are retried with a randomized exponential backoff (SMW_SX1276M0_JOIN_BACKOFF_*),
+//        so seed the random generator with <randomSeed()> and a value unique to each device
+bool SMW_SX1276M0::join_async(uint32_t deadline){
+  if(_connected || (_join_state == JoinState::JOINING)){
+    return false;
+  }
+
+  _join_state = JoinState::JOINING;
+  _join_step = SMW_SX1276M0_JOIN_STEP_SEND;
+  _join_attempts = 0;
+  _join_start = millis();
+  _join_deadline = deadline;
+  _join_backoff = 0;
+  return true;
+}
+
+// --------------------------------------------------
+
+// Check if there is a command waiting for its response
+//  @returns true if a response is pending [bool]
+bool SMW_SX1276M0::isBusy(void){
+  return _busy;
+}
+
+// --------------------------------------------------
+
 // Check if the module is connected to the network
 //  @returns true if the device is connected [bool]
 //  NOTE: it is better to check via the NJS command
@@ -665,202 +1539,101 @@ bool SMW_SX1276M0::isSleeping(void){
 //  @param (call_event) : true to call the event [bool] (default: true)
 //  @returns the status of the buffer [CommandResponse]
 //  NOTE: return ERROR if no data was read, DATA if there is data in the buffer or OK is an event was called
+//  NOTE: the events received during the commands are called first (all of them)
 CommandResponse SMW_SX1276M0::listen(bool call_event){
-  _buffer.reset(); // reset the buffer
+  // call the events received during the last commands
+  if(!_busy && (_event_count > 0)){
+    _event_deliver(call_event);
+    return CommandResponse::OK;
+  }
+
+  if(!_busy){
+    _buffer.reset(); // reset the buffer (only if not storing a response)
+  }
 
   // read the incoming data
-  uint8_t c;
   uint32_t timeout = millis() + SMW_SX1276M0_DELAY_INCOMING_DATA;
   while(millis() < timeout){
     if(_stream->available()){
-      c = _stream->read(); // read the incoming byte
-      
-#ifdef SMW_SX1276M0_DEBUG
-      // debug
-      if(_stream_debug){
-        if(c > 32){
-          _stream_debug->write(c);
-        } else {
-          _stream_debug->print('(');
-          _stream_debug->print('x');
-          _stream_debug->print(c, HEX);
-          _stream_debug->print(')');
-        }
-      }
-#endif
-  
       // check for new line
-      if((c == 0) || (c == CHAR_LF) || (c == CHAR_CR)){
-//        _delay(1); // wait some time for the next character to arrive
-        // wait some time for the data to arrive (without adding more time)
-        while(millis() < timeout){
-          if(_stream->available()){
-            uint8_t p = _stream->peek();
-            if((p == 0) || (p == CHAR_LF) || (p == CHAR_CR)){
-              _stream->read(); // flush the LF or CR character
-            }
-            break; // exit the timeout
-          }
-        }
-        break; // line read, move to the next
-      } else {
-        _buffer.append(c);
-        timeout = millis() + SMW_SX1276M0_DELAY_INCOMING_DATA; // give more time for the data to arrive
+      if(_parse(_stream->read())){
+        return _process_line(call_event);
       }
+      timeout = millis() + SMW_SX1276M0_DELAY_INCOMING_DATA; // give more time for the data to arrive
     }
   }
 
-  // check for a valid buffer
-  if(!_buffer.available()){
-    return CommandResponse::ERROR; // not the expected result, but treat as no message
-  }
+  // treat the incomplete line as the message (if any)
+  return _process_line(call_event);
+}
 
-  // get a copy of the buffer
-  uint8_t data_length = _buffer.available();
-  uint8_t data[data_length];
-  _buffer.copy(data);
-  
-#ifdef SMW_SX1276M0_DEBUG
-  // debug
-  if(_stream_debug){
-    _buffer.print(_stream_debug);
-  }
-#endif
+// --------------------------------------------------
 
-  // check for the event header
-  void *ptr = memmem(data, data_length, RSPNS_EVENT, strlen(RSPNS_EVENT));
-  if(ptr){
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->println(F("Found E")); // DEBUG
+// Process all the complete lines already received, without waiting
+//  @param (call_event) : true to call the events [bool] (default: true)
+//  @returns the number of lines processed (events and other lines) [uint16_t]
+//  NOTE: a partial line is kept for the next call
+//  NOTE: the buffer holds only the last line (the data of a RECV event must be read in the event)
+uint16_t SMW_SX1276M0::listen_all(bool call_event){
+  uint16_t count = 0;
+  while(!_busy){
+    // call the events received during the commands (including those sent by the events)
+    if(_event_count > 0){
+      count += _event_deliver(call_event);
+      continue;
     }
-#endif
 
-    // check for sleep
-    ptr = memmem(data, data_length, RSPNS_SLEEP, strlen(RSPNS_SLEEP));
-    if(ptr){
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->println(F("Found S")); // DEBUG
-    }
-#endif
-      _buffer.reset(); // flush the buffer
-      _sleeping = true; // set
-      
-      // call the event
-      if(event_listener && call_event){
-        event_listener(Event::SLEEP);
-      }
-    
-      return CommandResponse::OK;
-    }
-    
-    // check for join
-    ptr = memmem(data, data_length, RSPNS_JOINED, strlen(RSPNS_JOINED));
-    if(ptr){
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->println(F("Found J")); // DEBUG
-    }
-#endif
-      _buffer.reset(); // flush the buffer
-      _connected = true; // set
-      
-      // call the event
-      if(event_listener && call_event){
-        event_listener(Event::JOINED);
-      }
-    
-      return CommandResponse::OK;
-    }
-    
-    // check for received message
-    ptr = memmem(data, data_length, RSPNS_RECV, strlen(RSPNS_RECV));
-    if(ptr){
-      // flush the start of the message
-      uint32_t ignore = reinterpret_cast<uint32_t>(ptr) + strlen(RSPNS_RECV) - reinterpret_cast<uint32_t>(data); // some microcontrollers are 32-bit wide
-      for(uint8_t i=0 ; i < ignore ; i++){
-        _buffer.read();
-      }
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->println(F("Found M")); // DEBUG
-      _stream_debug->print(F("Ignore:")); // DEBUG
-      _stream_debug->println(ignore); // DEBUG
-      _buffer.print(_stream_debug); // DEBUG
+    if(!_stream->available()){
+      break;
     }
-#endif
-
-      // get the type of the command received (string or HEX)
-      uint8_t type = 0;
-      if(_buffer.available()){
-        type = _buffer.read();
-      }
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->print(F("Type:")); // DEBUG
-      _stream_debug->println(type, HEX); // DEBUG
+    if(_parse(_stream->read())){
+      _process_line(call_event);
+      count++;
     }
-#endif
+  }
+  return count;
+}
 
-      // the module seems to trigger the event before actually storing
-      //  the message, so a delay prevents an empty return value for a
-      //  subsequent reading (it should help when using the library)
-      _delay(10);
+// --------------------------------------------------
 
-      if(type == CHAR_SPACE){
-        // call the event
-        if(event_listener && call_event){
-          event_listener(Event::RECEIVED);
-        }
-      } else if(type == 'B'){
-        _buffer.read(); // flush one character
-        // call the event
-        if(event_listener && call_event){
-          event_listener(Event::RECEIVED_X);
-        }
-      } else {
-        return CommandResponse::ERROR; // wrong result
-      }
-      
-      return CommandResponse::DATA;
+// Send a binary message, storing it in a store-and-forward log if it can't be sent now
+//  @param (log)    : the log [UplinkLog (&)]
+//         (port)   : the application port [uint8_t]
+//         (data)   : the data to send [uint8_t *]
+//         (length) : the length of the data [size_t]
+//  @returns OK if the message was sent or stored, TOO_LONG or ERROR [CommandResponse]
+//  NOTE: the message is sent right away only if connected and the log is empty
+//        (to keep the order), otherwise use <forward()> to send the log
+//  NOTE: the message is stored only if it fits in a record of the log
+CommandResponse SMW_SX1276M0::log_sendX(UplinkLog &log, uint8_t port, const uint8_t *data, size_t length){
+  if(_connected && (log.available() == 0)){
+    CommandResponse res = sendX(port, data, length);
+    if((res == CommandResponse::OK) || (res == CommandResponse::TOO_LONG)){
+      return res;
     }
   }
-  
-  // check for the reset header
-  ptr = memmem(data, data_length, RSPNS_BOOT, sizeof(RSPNS_BOOT));
-  if(ptr){
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->println(F("Found R")); // DEBUG
-    }
-#endif
-    _buffer.reset(); // flush the buffer
-    _connected = false; // reset
 
-    // check if the module was sleeping
-    if(_sleeping){
-      _sleeping = false; // reset
-      // NOTE: the wakeup reset could be done with "Wakeup by RTC", but
-      //       the reset of the module already means it has awoken.
-      
-      // call the event
-      if(event_listener && call_event){
-        event_listener(Event::WAKEUP);
-      }
-    } else {
-      _reset = true; // set
-      
-      // call the event
-      if(event_listener && call_event){
-        event_listener(Event::RESET); // simple reset
-      }
-    }
-    
-    return CommandResponse::OK;
+  if((length > log.data_size()) || !log.append(port, data, length)){
+    return CommandResponse::ERROR;
   }
+  return CommandResponse::OK;
+}
+
+// --------------------------------------------------
 
-  return CommandResponse::DATA; // there is data in the buffer
+// Get the maximum application payload with the current region and data rate
+//  @returns the maximum length in bytes (0 if unknown) [uint8_t]
+//  NOTE: the region and the data rate are read if they aren't in the shadow
+//  NOTE: with ADR, the data rate is read again after each uplink
+uint8_t SMW_SX1276M0::max_payload(void){
+  _apply_read(SMW_SX1276M0_SHADOW_REGION);
+  _apply_read(SMW_SX1276M0_SHADOW_DR);
+
+  const uint32_t mask = (1UL << SMW_SX1276M0_SHADOW_REGION) | (1UL << SMW_SX1276M0_SHADOW_DR);
+  if((_shadow_valid & mask) != mask){
+    return 0;
+  }
+  return ::max_payload(_shadow[SMW_SX1276M0_SHADOW_REGION], _shadow[SMW_SX1276M0_SHADOW_DR]);
 }
 
 // --------------------------------------------------
@@ -874,6 +1647,38 @@ CommandResponse SMW_SX1276M0::ping(void){
 
 // --------------------------------------------------
 
+// Process the incoming data without blocking
+//  NOTE: the events are called for every complete line and the result of an
+//        asynchronous command is given by <response_listener> or <get_LastResponse()>
+//  NOTE: returns right after the end of a command, so that its data remains in the buffer
+//  NOTE: the events received during a command are called in the next call
+void SMW_SX1276M0::poll(void){
+  if(!_busy){
+    _event_deliver(true); // call the events received during the last commands
+  }
+  _join_process(); // update the join (if any)
+  _confirmed_process(); // queue the next confirmed message (if any)
+  _schedule_dispatch(); // queue the next scheduled message (if any)
+  _issue_queued(); // send the next command (if any)
+
+  while(_stream->available()){
+    bool busy = _busy;
+    if(_parse(_stream->read())){
+      _process_line(true);
+    }
+    if(busy && !_busy){
+      return; // command finished
+    }
+  }
+
+  // check for the timeout of the pending command
+  if(_busy && ((millis() - _command_start) >= _command_timeout)){
+    _finish_response();
+  }
+}
+
+// --------------------------------------------------
+
 // Read a text message from the module
 //  @returns the type of the response [CommandResponse]
 //  NOTE: the data must be obtained from the buffer
@@ -902,38 +1707,34 @@ CommandResponse SMW_SX1276M0::readT(Buffer (&buffer)){
 CommandResponse SMW_SX1276M0::readT(uint8_t (&port), Buffer (&buffer)){
   CommandResponse res = readT(); // read the message
 
-  // parse the message
-  uint8_t b;
-  bool payload = false;
-  char sport[5] = { CHAR_EOS }; // 0 to 9999
-  uint8_t index = 0;
-  while (_buffer.available()){
-    b = _buffer.read();
-
-    // check for delimitter
-    if(b == CHAR_COLON){
-      payload = true; // set
-      buffer.resize(_buffer.available()); // resize the buffer
-      continue;
-    }
-
-    // parse
-    if(!payload){
-      if((index < 4) && isdigit(b)){
-        sport[index++] = b;
-        sport[index] = CHAR_EOS;
-      }
-    } else {
-      buffer.append(b);
+  // parse the message and copy the payload
+  PayloadView payload;
+  _parse_payload(_buffer, 0, port, payload);
+  if(payload.data){
+    buffer.resize(payload.length); // resize the buffer
+    for(uint16_t i=0 ; i < payload.length ; i++){
+      buffer.append(payload.data[i]);
     }
   }
-  port = atoi(sport); // convert
 
   return res;
 }
 
 // --------------------------------------------------
 
+// Read a text message from the module without copying the payload
+//  @param (port) : the application port [uint8_t (&)]
+//         (payload) : the view of the payload in the internal buffer [PayloadView (&)]
+//  @returns the type of the response [CommandResponse]
+//  NOTE: the view is valid until the next command or <listen()>/<poll()>
+CommandResponse SMW_SX1276M0::readT(uint8_t (&port), PayloadView (&payload)){
+  CommandResponse res = readT(); // read the message
+  _parse_payload(_buffer, 0, port, payload);
+  return res;
+}
+
+// --------------------------------------------------
+
 // Read an hexadecimal message from the module
 //  @returns the type of the response [CommandResponse]
 //  NOTE: the data must be obtained from the buffer
@@ -961,32 +1762,67 @@ CommandResponse SMW_SX1276M0::readX(Buffer (&buffer)){
 CommandResponse SMW_SX1276M0::readX(uint8_t (&port), Buffer (&buffer)){
   CommandResponse res = readX(); // read the message
 
-  // parse the message
-  uint8_t b;
-  bool payload = false;
-  char sport[5] = { CHAR_EOS }; // 0 to 9999
-  uint8_t index = 0;
-  while (_buffer.available()){
-    b = _buffer.read();
-
-    // check for delimitter
-    if(b == CHAR_COLON){
-      payload = true; // set
-      buffer.resize(_buffer.available()); // resize the buffer
-      continue;
+  // parse the message and copy the payload
+  PayloadView payload;
+  _parse_payload(_buffer, 0, port, payload);
+  if(payload.data){
+    buffer.resize(payload.length); // resize the buffer
+    for(uint16_t i=0 ; i < payload.length ; i++){
+      buffer.append(payload.data[i]);
     }
+  }
 
-    // parse
-    if(!payload){
-      if((index < 4) && isdigit(b)){
-        sport[index++] = b;
-        sport[index] = CHAR_EOS;
-      }
-    } else {
-      buffer.append(b);
-    }
+  return res;
+}
+
+// --------------------------------------------------
+
+// Read an hexadecimal message from the module without copying the payload
+//  @param (port) : the application port [uint8_t (&)]
+//         (payload) : the view of the payload in the internal buffer [PayloadView (&)]
+//  @returns the type of the response [CommandResponse]
+//  NOTE: the view is valid until the next command or <listen()>/<poll()>
+CommandResponse SMW_SX1276M0::readX(uint8_t (&port), PayloadView (&payload)){
+  CommandResponse res = readX(); // read the message
+  _parse_payload(_buffer, 0, port, payload);
+  return res;
+}
+
+// --------------------------------------------------
+
+// Read an hexadecimal message from the module and decode it to bytes
+//  @param (port)   : the application port [uint8_t (&)]
+//         (data)   : the array to store the payload [uint8_t *]
+//         (size)   : the size of the array [uint16_t]
+//         (length) : the number of bytes decoded [uint16_t (&)]
+//  @returns the type of the response [CommandResponse]
+//  NOTE: the payload is decoded as it arrives, so it is not stored in the buffer
+//  NOTE: returns ERROR if the payload is not valid hexadecimal data (odd
+//        number of characters or invalid character)
+//  NOTE: the bytes that don't fit in the array are discarded (see <get_Overflow()>)
+CommandResponse SMW_SX1276M0::readX(uint8_t (&port), uint8_t *data, uint16_t size, uint16_t (&length)){
+  _decode_data = data;
+  _decode_size = size;
+  _decode_length = 0;
+
+  // send the command and read the response
+  //  NOTE: the decoder is armed only after the command is sent, because
+  //        <_send_command()> first waits for the pending commands (if any),
+  //        whose responses must not be decoded
+  _send_command(CMD_RECVB);
+  _decode_state = SMW_SX1276M0_DECODE_PORT;
+  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_READ_DOWNLINK);
+
+  // parse the port
+  PayloadView payload;
+  _parse_payload(_buffer, 0, port, payload);
+  length = _decode_length;
+
+  // check for malformed data
+  if((res == CommandResponse::OK) && (_decode_state == SMW_SX1276M0_DECODE_ERROR)){
+    res = CommandResponse::ERROR;
   }
-  port = atoi(sport); // convert
+  _decode_state = SMW_SX1276M0_DECODE_OFF; // reset
 
   return res;
 }
@@ -1016,35 +1852,51 @@ CommandResponse SMW_SX1276M0::reset(void){
 
 // --------------------------------------------------
 
+// Schedule a text message
+//  @param (port)     : the application port [uint8_t]
+//         (data)     : the text data to send [char *]
+//         (priority) : the priority of the message (the highest first) [uint8_t]
+//         (deadline) : the maximum time to wait before sending [ms] [uint32_t]
+//         (callback) : the function to call with the result [CommandCallback] (default: nullptr)
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns true if the message was scheduled [bool]
+//  NOTE: the data is not copied, so it must remain valid until the callback
+//  NOTE: see <_schedule_dispatch()> for the order of the messages
+bool SMW_SX1276M0::schedule_sendT(uint8_t port, const char *data, uint8_t priority, uint32_t deadline, CommandCallback callback, void *context){
+  return _schedule_add(CMD_SEND, port, data, priority, deadline, callback, context);
+}
+
+// --------------------------------------------------
+
+// Schedule an hexadecimal message
+//  @param (port)     : the application port [uint8_t]
+//         (data)     : the hexadecimal data to send [char *]
+//         (priority) : the priority of the message (the highest first) [uint8_t]
+//         (deadline) : the maximum time to wait before sending [ms] [uint32_t]
+//         (callback) : the function to call with the result [CommandCallback] (default: nullptr)
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns true if the message was scheduled [bool]
+//  NOTE: the data is not copied, so it must remain valid until the callback
+//  NOTE: see <_schedule_dispatch()> for the order of the messages
+bool SMW_SX1276M0::schedule_sendX(uint8_t port, const char *data, uint8_t priority, uint32_t deadline, CommandCallback callback, void *context){
+  return _schedule_add(CMD_SENDB, port, data, priority, deadline, callback, context);
+}
+
+// --------------------------------------------------
+
 // Send a text message
 //  @param (port) : the application port [uint8_t]
 //         (data) : the text data to send [char *]
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::sendT(uint8_t port, const char *data){
-  // parse the port
-  uint8_t aport = port; // auxiliary variable for <port>
-  uint8_t temp[3];
-
-  temp[0] = aport / 100;
-  aport %= 100;
-  temp[1] = aport / 10;
-  temp[2] = aport % 10;
-
-  // set the header (port)
-  uint8_t sport[5]; // port stringified
-  uint8_t index = 0;
-  aport = 0; // reset
-  for(uint8_t i=0 ; i < 3 ; i++){
-    if((temp[i] > 0) || (aport > 0)){
-      sport[index++] = temp[i] + '0'; // convert to ASCII character
-    }
-    aport += temp[i]; // update (simple)
+  // check the uplink
+  CommandResponse res = _uplink_check(payload_length(CMD_SEND, data), true);
+  if(res != CommandResponse::OK){
+    return res;
   }
-  sport[index++] = CHAR_COLON;
-  sport[index] = CHAR_EOS;
-  
+
   // send the command and read the response
-  _send_command(CMD_SEND, 2, sport, data);
+  _send_payload(CMD_SEND, port, data);
   return _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 }
 
@@ -1055,7 +1907,7 @@ CommandResponse SMW_SX1276M0::sendT(uint8_t port, const char *data){
 //         (data) : the text data to send [String]
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::sendT(uint8_t port, const String data){
-  uint8_t length = data.length() + 1;
+  uint16_t length = data.length() + 1;
   char cdata[length]; // create a temporary string
   data.toCharArray(cdata, length); // copy the data (with automatic EOS)
   return sendT(port, cdata);
@@ -1063,35 +1915,42 @@ CommandResponse SMW_SX1276M0::sendT(uint8_t port, const String data){
 
 // --------------------------------------------------
 
+// Send a text message without waiting for the response
+//  @param (port) : the application port [uint8_t]
+//         (data) : the text data to send [char *]
+//  @returns OK if the command was sent, ERROR if another command is pending, DUTY_CYCLE or TOO_LONG [CommandResponse]
+//  NOTE: the result is given by <response_listener> or <get_LastResponse()> (<poll()>)
+CommandResponse SMW_SX1276M0::sendT_async(uint8_t port, const char *data){
+  if(_busy){
+    return CommandResponse::ERROR;
+  }
+
+  // check the uplink
+  CommandResponse res = _uplink_check(payload_length(CMD_SEND, data), false);
+  if(res != CommandResponse::OK){
+    return res;
+  }
+
+  _send_payload(CMD_SEND, port, data);
+  _begin_response(SMW_SX1276M0_TIMEOUT_WRITE, true);
+  return CommandResponse::OK;
+}
+
+// --------------------------------------------------
+
 // Send an hexadecimal message
 //  @param (port) : the application port [uint8_t]
 //         (data) : the text data to send [char *]
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::sendX(uint8_t port, const char *data){
-  // parse the port
-  uint8_t aport = port; // auxiliary variable for <port>
-  uint8_t temp[3];
-
-  temp[0] = aport / 100;
-  aport %= 100;
-  temp[1] = aport / 10;
-  temp[2] = aport % 10;
-
-  // set the header (port)
-  uint8_t sport[5]; // port stringified
-  uint8_t index = 0;
-  aport = 0; // reset
-  for(uint8_t i=0 ; i < 3 ; i++){
-    if((temp[i] > 0) || (aport > 0)){
-      sport[index++] = temp[i] + '0'; // convert to ASCII character
-    }
-    aport += temp[i]; // update (simple)
+  // check the uplink
+  CommandResponse res = _uplink_check(payload_length(CMD_SENDB, data), true);
+  if(res != CommandResponse::OK){
+    return res;
   }
-  sport[index++] = CHAR_COLON;
-  sport[index] = CHAR_EOS;
-  
+
   // send the command and read the response
-  _send_command(CMD_SENDB, 2, sport, data);
+  _send_payload(CMD_SENDB, port, data);
   return _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 }
 
@@ -1102,7 +1961,7 @@ CommandResponse SMW_SX1276M0::sendX(uint8_t port, const char *data){
 //         (data) : the text data to send [String]
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::sendX(uint8_t port, const String data){
-  uint8_t length = data.length() + 1;
+  uint16_t length = data.length() + 1;
   char cdata[length]; // create a temporary string
   data.toCharArray(cdata, length); // copy the data (with automatic EOS)
   return sendX(port, cdata);
@@ -1110,42 +1969,159 @@ CommandResponse SMW_SX1276M0::sendX(uint8_t port, const String data){
 
 // --------------------------------------------------
 
-// Set the Adaptive Data Rate
-//  @param (adr) : the data to be sent [uint8_t]
+// Send a binary message (encoded in hexadecimal while sending)
+//  @param (port)   : the application port [uint8_t]
+//         (data)   : the binary data to send [uint8_t *]
+//         (length) : the length of the data in bytes [size_t]
 //  @returns the type of the response [CommandResponse]
-CommandResponse SMW_SX1276M0::set_ADR(uint8_t adr){
-  adr = (adr == SMW_SX1276M0_ADR_ON) ? SMW_SX1276M0_ADR_ON : SMW_SX1276M0_ADR_OFF; // force binary value
-  adr += '0'; // convert to ASCII character
-  char data[] = { static_cast<char>(adr) , CHAR_EOS}; // (static cast to avoid narrowing conversion warnings)
-  
-  // send the command and read the response
-  _send_command(CMD_ADR, 1, data);
-  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+CommandResponse SMW_SX1276M0::sendX(uint8_t port, const uint8_t *data, size_t length){
+  // check the uplink
+  CommandResponse res = _uplink_check(length, true);
+  if(res != CommandResponse::OK){
+    return res;
+  }
 
-  return res;
+  // send the command and read the response
+  _send_payload(CMD_SENDB, port, data, length);
+  return _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 }
 
 // --------------------------------------------------
 
-// Set the Automatic Join
-//  @param (ajoin) : the data to be sent [uint8_t]
-//  @returns the type of the response [CommandResponse]
-CommandResponse SMW_SX1276M0::set_AJoin(uint8_t ajoin){
-  ajoin = (ajoin == SMW_SX1276M0_AUTOMATIC_JOIN_ON) ? SMW_SX1276M0_AUTOMATIC_JOIN_ON : SMW_SX1276M0_AUTOMATIC_JOIN_OFF; // force binary value
-  ajoin += '0'; // convert to ASCII character
-  char data[] = { static_cast<char>(ajoin), CHAR_EOS}; // (static cast to avoid narrowing conversion warnings)
-  
-  // send the command and read the response
-  _send_command(CMD_AJOIN, 1, data);
-  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+// Send a binary message of any length in fragments sized to the current data rate
+//  @param (port)   : the application port [uint8_t]
+//         (data)   : the data to send [uint8_t *]
+//         (length) : the length of the data [size_t]
+//  @returns the type of the response (OK if all the fragments were sent) [CommandResponse]
+//  NOTE: each fragment starts with a header (see "Fragment.h"), so the
+//        message can be rebuilt with a <SMW_SX1276M0_Reassembler>
+//  NOTE: blocking, including the wait for the duty cycle between the fragments
+//        (<poll()> is called while waiting). The time is bounded by the number
+//        of fragments times the off time of each one (airtime / duty cycle):
+//        700 bytes at EU868 DR0 (1 %) are 15 fragments and take about 65 min,
+//        and the limit of 255 fragments can take more than 18 h. To send
+//        without blocking, call <sendX()> from the loop with the header of
+//        each fragment and retry while it returns DUTY_CYCLE.
+//  NOTE: returns TOO_LONG if more than SMW_SX1276M0_FRAGMENT_MAX_COUNT fragments are needed
+//        or if the data rate drops (ADR) below the size of the fragments
+CommandResponse SMW_SX1276M0::sendFragmented(uint8_t port, const uint8_t *data, size_t length){
+  // get the size of the fragments
+  uint8_t max_length = max_payload();
+  if(max_length <= SMW_SX1276M0_FRAGMENT_HEADER_SIZE){
+    return CommandResponse::ERROR; // unknown data rate
+  }
+  uint8_t chunk = max_length - SMW_SX1276M0_FRAGMENT_HEADER_SIZE;
+  size_t count = (length + chunk - 1) / chunk;
+  if(count == 0){
+    count = 1; // empty message
+  }
+  if(count > SMW_SX1276M0_FRAGMENT_MAX_COUNT){
+    return CommandResponse::TOO_LONG;
+  }
+
+  uint8_t header[SMW_SX1276M0_FRAGMENT_HEADER_SIZE];
+  header[SMW_SX1276M0_FRAGMENT_HEADER_ID] = _fragment_id++;
+  header[SMW_SX1276M0_FRAGMENT_HEADER_COUNT] = count;
+
+  CommandResponse res = CommandResponse::OK;
+  for(size_t index=0 ; index < count ; index++){
+    size_t offset = index * chunk;
+    size_t fragment_length = ((length - offset) < chunk) ? (length - offset) : chunk;
+    header[SMW_SX1276M0_FRAGMENT_HEADER_INDEX] = index;
+
+    // check the data rate (it might have changed with the ADR)
+    if(max_payload() < (SMW_SX1276M0_FRAGMENT_HEADER_SIZE + fragment_length)){
+      return CommandResponse::TOO_LONG;
+    }
+
+    // wait for the duty cycle
+    while(_uplink_gate && (get_UplinkWait() > 0)){
+      poll();
+    }
+
+    _send_payload(CMD_SENDB, port, &data[offset], fragment_length, header, SMW_SX1276M0_FRAGMENT_HEADER_SIZE);
+    res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+    if(res != CommandResponse::OK){
+      break;
+    }
+  }
 
   return res;
 }
 
 // --------------------------------------------------
 
-// Set the RTC wakeup time
-//  @param (alarm) : the data to be sent [uint32_t]
+// Send an hexadecimal message without waiting for the response
+//  @param (port) : the application port [uint8_t]
+//         (data) : the text data to send [char *]
+//  @returns OK if the command was sent, ERROR if another command is pending, DUTY_CYCLE or TOO_LONG [CommandResponse]
+//  NOTE: the result is given by <response_listener> or <get_LastResponse()> (<poll()>)
+CommandResponse SMW_SX1276M0::sendX_async(uint8_t port, const char *data){
+  if(_busy){
+    return CommandResponse::ERROR;
+  }
+
+  // check the uplink
+  CommandResponse res = _uplink_check(payload_length(CMD_SENDB, data), false);
+  if(res != CommandResponse::OK){
+    return res;
+  }
+
+  _send_payload(CMD_SENDB, port, data);
+  _begin_response(SMW_SX1276M0_TIMEOUT_WRITE, true);
+  return CommandResponse::OK;
+}
+
+// --------------------------------------------------
+
+// Set the Adaptive Data Rate
+//  @param (adr) : the data to be sent [uint8_t]
+//  @returns the type of the response [CommandResponse]
+CommandResponse SMW_SX1276M0::set_ADR(uint8_t adr){
+  adr = (adr == SMW_SX1276M0_ADR_ON) ? SMW_SX1276M0_ADR_ON : SMW_SX1276M0_ADR_OFF; // force binary value
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_ADR, adr)){
+    return CommandResponse::OK; // already set
+  }
+
+  char data[] = { static_cast<char>(adr + '0') , CHAR_EOS}; // convert to ASCII character (static cast to avoid narrowing conversion warnings)
+  
+  // send the command and read the response
+  _send_command(CMD_ADR, 1, data);
+  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+
+  _shadow_update(SMW_SX1276M0_SHADOW_ADR, adr, res);
+  return res;
+}
+
+// --------------------------------------------------
+
+// Set the Automatic Join
+//  @param (ajoin) : the data to be sent [uint8_t]
+//  @returns the type of the response [CommandResponse]
+CommandResponse SMW_SX1276M0::set_AJoin(uint8_t ajoin){
+  ajoin = (ajoin == SMW_SX1276M0_AUTOMATIC_JOIN_ON) ? SMW_SX1276M0_AUTOMATIC_JOIN_ON : SMW_SX1276M0_AUTOMATIC_JOIN_OFF; // force binary value
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_AJOIN, ajoin)){
+    return CommandResponse::OK; // already set
+  }
+
+  char data[] = { static_cast<char>(ajoin + '0'), CHAR_EOS}; // convert to ASCII character (static cast to avoid narrowing conversion warnings)
+  
+  // send the command and read the response
+  _send_command(CMD_AJOIN, 1, data);
+  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+
+  _shadow_update(SMW_SX1276M0_SHADOW_AJOIN, ajoin, res);
+  return res;
+}
+
+// --------------------------------------------------
+
+// Set the RTC wakeup time
+//  @param (alarm) : the data to be sent [uint32_t]
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::set_Alarm(uint32_t alarm){
   // check the value
@@ -1176,11 +2152,17 @@ CommandResponse SMW_SX1276M0::set_AppEUI(const char *appeui){
   char str[SMW_SX1276M0_SIZE_APPEUI + 1];
   str[SMW_SX1276M0_SIZE_APPEUI] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_APPEUI, appeui, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_APPEUI, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_APPEUI, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_APPEUI, str, res);
   return res;
 }
 
@@ -1194,11 +2176,17 @@ CommandResponse SMW_SX1276M0::set_AppKey(const char *appkey){
   char str[SMW_SX1276M0_SIZE_APPKEY + 1];
   str[SMW_SX1276M0_SIZE_APPKEY] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_APPKEY, appkey, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_APPKEY, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_APPKEY, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_APPKEY, str, res);
   return res;
 }
 
@@ -1212,11 +2200,17 @@ CommandResponse SMW_SX1276M0::set_AppSKey(const char *appskey){
   char str[SMW_SX1276M0_SIZE_APPSKEY + 1];
   str[SMW_SX1276M0_SIZE_APPSKEY] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_APPSKEY, appskey, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_APPSKEY, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_APPSKEY, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_APPSKEY, str, res);
   return res;
 }
 
@@ -1231,12 +2225,18 @@ CommandResponse SMW_SX1276M0::set_Confirmation(uint8_t confirm_mode){
     return CommandResponse::ERROR;
   }
 
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_CONFIRMATION, confirm_mode)){
+    return CommandResponse::OK; // already set
+  }
+
   char data[2] = { CHAR_EOS };
   snprintf(data, sizeof(data), "%d%c", confirm_mode, CHAR_EOS);
 
   // send the command and read the response
   _send_command(CMD_CONFIRMATION, 1, data);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE);
+  _shadow_update(SMW_SX1276M0_SHADOW_CONFIRMATION, confirm_mode, res);
   return res;
 }
 
@@ -1250,11 +2250,17 @@ CommandResponse SMW_SX1276M0::set_DevAddr(const char *devaddr){
   char str[SMW_SX1276M0_SIZE_DEVADDR + 1];
   str[SMW_SX1276M0_SIZE_DEVADDR] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_DEVADDR, devaddr, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_DEVADDR, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_DADDR, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_DEVADDR, str, res);
   return res;
 }
 
@@ -1268,11 +2274,17 @@ CommandResponse SMW_SX1276M0::set_DevEUI(const char *deveui){
   char str[SMW_SX1276M0_SIZE_DEVEUI + 1];
   str[SMW_SX1276M0_SIZE_DEVEUI] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_DEVEUI, deveui, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_DEVEUI, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_DEVEUI, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_DEVEUI, str, res);
   return res;
 }
 
@@ -1286,14 +2298,19 @@ CommandResponse SMW_SX1276M0::set_DR(uint8_t dr){
   if(dr > 7){
     return CommandResponse::ERROR;
   }
-  
-  dr += '0'; // convert to ASCII character
-  char data[] = { static_cast<char>(dr), CHAR_EOS}; // (static cast to avoid narrowing conversion warnings)
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_DR, dr)){
+    return CommandResponse::OK; // already set
+  }
+
+  char data[] = { static_cast<char>(dr + '0'), CHAR_EOS}; // convert to ASCII character (static cast to avoid narrowing conversion warnings)
   
   // send the command and read the response
   _send_command(CMD_DR, 1, data);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_DR, dr, res);
   return res;
 }
 
@@ -1304,13 +2321,19 @@ CommandResponse SMW_SX1276M0::set_DR(uint8_t dr){
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::set_Echo(uint8_t echo){
   echo = (echo == SMW_SX1276M0_ECHO_ON) ? SMW_SX1276M0_ECHO_ON : SMW_SX1276M0_ECHO_OFF; // force binary value
-  echo += '0'; // convert to ASCII character
-  char data[] = { static_cast<char>(echo), CHAR_EOS}; // (static cast to avoid narrowing conversion warnings)
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_ECHO, echo)){
+    return CommandResponse::OK; // already set
+  }
+
+  char data[] = { static_cast<char>(echo + '0'), CHAR_EOS}; // convert to ASCII character (static cast to avoid narrowing conversion warnings)
   
   // send the command and read the response
   _send_command(CMD_ECHO, 1, data);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_ECHO, echo, res);
   return res;
 }
 
@@ -1326,15 +2349,21 @@ CommandResponse SMW_SX1276M0::set_JoinMode(uint8_t mode){
     return CommandResponse::ERROR;
   }
 
-  mode += '0'; // convert to ASCII character
-  char data[] = { static_cast<char>(mode) , CHAR_EOS}; // (static cast to avoid narrowing conversion warnings)
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_JOIN_MODE, mode)){
+    return CommandResponse::OK; // already set
+  }
+
+  char data[] = { static_cast<char>(mode + '0') , CHAR_EOS}; // convert to ASCII character (static cast to avoid narrowing conversion warnings)
   
   // send the command and read the response
   _send_command(CMD_NJM, 1, data);
 
   _reset = false; // reset
 
-  return _read_reset();
+  CommandResponse res = _read_reset();
+  _shadow_update(SMW_SX1276M0_SHADOW_JOIN_MODE, mode, res); // (after the reset)
+  return res;
 }
 
 // --------------------------------------------------
@@ -1348,12 +2377,18 @@ CommandResponse SMW_SX1276M0::set_NumberOfRetries(uint8_t num_retries){
     return CommandResponse::ERROR;
   }
 
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_RETRIES, num_retries)){
+    return CommandResponse::OK; // already set
+  }
+
   char data[2] = { CHAR_EOS };
   snprintf(data, sizeof(data), "%d%c", num_retries, CHAR_EOS);
 
   // send the command and read the response
   _send_command(CMD_NUM_RETRIES, 1, data);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE);
+  _shadow_update(SMW_SX1276M0_SHADOW_RETRIES, num_retries, res);
   return res;
 }
 
@@ -1367,11 +2402,17 @@ CommandResponse SMW_SX1276M0::set_NwkSKey(const char *nwkskey){
   char str[SMW_SX1276M0_SIZE_NWKSKEY + 1];
   str[SMW_SX1276M0_SIZE_NWKSKEY] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_NWKSKEY, nwkskey, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_NWKSKEY, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_NWKSKEY, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_NWKSKEY, str, res);
   return res;
 }
 
@@ -1385,11 +2426,17 @@ CommandResponse SMW_SX1276M0::set_P2P_DevAddr(const char *devaddr){
   char str[SMW_SX1276M0_SIZE_DEVADDR + 1];
   str[SMW_SX1276M0_SIZE_DEVADDR] = CHAR_EOS;
   filter_string(str, SMW_SX1276M0_SIZE_DEVADDR, devaddr, FILTER_HEX);
+
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_P2P_DEVADDR, str)){
+    return CommandResponse::OK; // already set
+  }
   
   // send the command and read the response
   _send_command(CMD_P2P_DADDR, 1, str);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
 
+  _shadow_update(SMW_SX1276M0_SHADOW_P2P_DEVADDR, str, res);
   return res;
 }
 
@@ -1404,12 +2451,18 @@ CommandResponse SMW_SX1276M0::set_P2P_SyncWord(uint8_t sync_word){
     return CommandResponse::ERROR;
   }
 
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_P2P_WORD, sync_word)){
+    return CommandResponse::OK; // already set
+  }
+
   char data[4] = { CHAR_EOS };
   snprintf(data, sizeof(data), "%d%c", sync_word, CHAR_EOS);
 
   // send the command and read the response
   _send_command(CMD_P2P_WORD, 1, data);
   CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+  _shadow_update(SMW_SX1276M0_SHADOW_P2P_WORD, sync_word, res);
   return res;
 }
 
@@ -1425,12 +2478,23 @@ CommandResponse SMW_SX1276M0::set_Region(uint8_t region){
     return CommandResponse::ERROR;
   }
 
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_REGION, region)){
+    return CommandResponse::OK; // already set
+  }
+
   char data[2] = { CHAR_EOS };
   snprintf(data, sizeof(data), "%d%c", region, CHAR_EOS);
 
   // send the command and read the response
   _send_command(CMD_REGION, 1, data);
-  return _read_reset();
+
+  _reset = false; // reset
+
+  CommandResponse res = _read_reset();
+
+  _shadow_update(SMW_SX1276M0_SHADOW_REGION, region, res); // (after the reset)
+  return res;
 }
 
 // --------------------------------------------------
@@ -1444,116 +2508,1683 @@ CommandResponse SMW_SX1276M0::set_TXPower(uint8_t tx_power){
     return CommandResponse::ERROR;
   }
 
-  char data[3] = { CHAR_EOS };
-  snprintf(data, sizeof(data), "%d%c", tx_power, CHAR_EOS);
+  // check the shadow
+  if(_shadow_check(SMW_SX1276M0_SHADOW_TXP, tx_power)){
+    return CommandResponse::OK; // already set
+  }
+
+  char data[3] = { CHAR_EOS };
+  snprintf(data, sizeof(data), "%d%c", tx_power, CHAR_EOS);
+
+  // send the command and read the response
+  _send_command(CMD_TXP, 1, data);
+  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
+  _shadow_update(SMW_SX1276M0_SHADOW_TXP, tx_power, res);
+  return res;
+}
+
+// --------------------------------------------------
+
+// Set the debugger of the object
+//  @param (debugger) : the stream to print to [Stream *]
+#ifdef SMW_SX1276M0_DEBUG
+void SMW_SX1276M0::setDebugger(Stream *debugger){
+  _stream_debug = debugger;
+}
+#endif
+
+// --------------------------------------------------
+
+// Set the handler of the downlinks on the ports without a handler
+//  @param (callback) : the function to call (nullptr to remove) [DownlinkCallback]
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  NOTE: see <setPortHandler()>
+void SMW_SX1276M0::setDefaultHandler(DownlinkCallback callback, void *context){
+  _default_handler = callback;
+  _default_context = context;
+}
+
+// --------------------------------------------------
+
+// Set the duty cycle gate of the uplinks
+//  @param (enabled) : true to refuse the uplinks before the end of the off time (DUTY_CYCLE) [bool]
+//  NOTE: the gate is enabled by default, but the duty cycle is always tracked
+void SMW_SX1276M0::setDutyCycle(bool enabled){
+  _uplink_gate = enabled;
+}
+
+// --------------------------------------------------
+
+// Set the pin for reset
+//  @param (pin_reset) : the pin to reset the module [int16_t]
+void SMW_SX1276M0::setPinReset(int16_t pin_reset){
+  _pin_reset = pin_reset;
+  pinMode(_pin_reset, OUTPUT);
+  digitalWrite(_pin_reset, LOW); // active HIGH
+}
+
+// --------------------------------------------------
+
+// Set the handler of the downlinks on a port
+//  @param (port)     : the application port (1 to 223) [uint8_t]
+//         (callback) : the function to call (nullptr to remove) [DownlinkCallback]
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//  @returns true if the handler was set (or removed) [bool]
+//  NOTE: if the port of a RECEIVED or RECEIVED_X event has a handler (or if
+//        there is a default handler), the library reads the message before
+//        calling the events, so the events must not read it again. The
+//        messages of the other ports are left for the events.
+//  NOTE: the hexadecimal messages are decoded to bytes (in place)
+bool SMW_SX1276M0::setPortHandler(uint8_t port, DownlinkCallback callback, void *context){
+  if((port < 1) || (port > 223)){
+    return false;
+  }
+
+#if SMW_SX1276M0_PORT_HANDLERS_SIZE > 0
+  int8_t index = _port_find(port);
+  if(index >= 0){
+    if(callback){
+      _port_handlers[index].callback = callback; // update
+      _port_handlers[index].context = context;
+      return true;
+    }
+
+    // remove and insert again the next entries of the cluster (linear probing)
+    _port_handlers[index] = { 0 , nullptr , nullptr }; // empty
+    _port_handler_count--;
+    const uint8_t mask = SMW_SX1276M0_PORT_HANDLERS_SIZE - 1;
+    for(uint8_t i=((index + 1) & mask) ; _port_handlers[i].port != 0 ; i=((i + 1) & mask)){
+      PortHandler handler = _port_handlers[i];
+      _port_handlers[i] = { 0 , nullptr , nullptr }; // empty
+      _port_handler_count--;
+      _port_insert(handler.port, handler.callback, handler.context);
+    }
+    return true;
+  }
+
+  if(!callback){
+    return true; // nothing to remove
+  }
+  return _port_insert(port, callback, context);
+#else
+  (void)context;
+  return !callback; // (no table)
+#endif
+}
+
+// --------------------------------------------------
+
+// Set the mode to read the response of the commands
+//  @param (mode) : SMW_SX1276M0_RESPONSE_MODE_COMPLETION to return as soon as the status
+//                  line is received or SMW_SX1276M0_RESPONSE_MODE_TIMEOUT to always wait
+//                  for the full timeout [uint8_t]
+void SMW_SX1276M0::setResponseMode(uint8_t mode){
+  _response_mode = (mode == SMW_SX1276M0_RESPONSE_MODE_TIMEOUT) ? SMW_SX1276M0_RESPONSE_MODE_TIMEOUT : SMW_SX1276M0_RESPONSE_MODE_COMPLETION; // force binary value
+}
+
+// --------------------------------------------------
+
+// Sleep
+//  @param (alarm) : the duration of the sleep [uint32_t] (default: 0)
+//  @returns the type of the response [CommandResponse]
+//  NOTE: <alarm = 0> means that the parameter is ignored
+//  NOTE: the confirmation is asynchronous (<listen()>)
+CommandResponse SMW_SX1276M0::sleep(uint32_t alarm){
+  // update the alarm if necessary
+  if(alarm){
+    CommandResponse res = set_Alarm(alarm);
+    if(res != CommandResponse::OK){
+      return res;
+    }
+  }
+
+  _send_command(CMD_SLEEP); // send the command
+
+  return CommandResponse::OK;
+}
+
+// --------------------------------------------------
+
+// Subscribe to the events
+//  @param (callback) : the function to call [EventCallback]
+//         (context)  : the context for the callback [void *] (default: nullptr)
+//         (mask)     : the events to receive (SMW_SX1276M0_EVENT_MASK()) [uint16_t] (default: SMW_SX1276M0_EVENT_ALL)
+//  @returns true if subscribed [bool]
+//  NOTE: the subscribers are called after <event_listener>, in the order of subscription
+//  NOTE: subscribing again with the same callback and context updates the mask
+bool SMW_SX1276M0::subscribe(EventCallback callback, void *context, uint16_t mask){
+  if(!callback){
+    return false;
+  }
+
+#if SMW_SX1276M0_SUBSCRIBERS_SIZE > 0
+  // check if already subscribed
+  for(uint8_t i=0 ; i < _subscriber_count ; i++){
+    if((_subscribers[i].callback == callback) && (_subscribers[i].context == context)){
+      _subscribers[i].mask = mask;
+      return true;
+    }
+  }
+
+  if(_subscriber_count >= SMW_SX1276M0_SUBSCRIBERS_SIZE){
+    return false;
+  }
+  Subscriber &subscriber = _subscribers[_subscriber_count++];
+  subscriber.callback = callback;
+  subscriber.context = context;
+  subscriber.mask = mask;
+  return true;
+#else
+  (void)context;
+  (void)mask;
+  return false; // (no table)
+#endif
+}
+
+// --------------------------------------------------
+
+// Unset the debugger of the object
+#ifdef SMW_SX1276M0_DEBUG
+void SMW_SX1276M0::unsetDebugger(void){
+  _stream_debug = nullptr;
+}
+#endif
+
+// --------------------------------------------------
+
+// Unsubscribe from the events
+//  @param (callback) : the function given to <subscribe()> [EventCallback]
+//         (context)  : the context given to <subscribe()> [void *] (default: nullptr)
+//  @returns true if unsubscribed [bool]
+//  NOTE: it can be called by a subscriber, the others still receive the event
+bool SMW_SX1276M0::unsubscribe(EventCallback callback, void *context){
+#if SMW_SX1276M0_SUBSCRIBERS_SIZE > 0
+  if(!callback){
+    return false;
+  }
+  for(uint8_t i=0 ; i < _subscriber_count ; i++){
+    if((_subscribers[i].callback == callback) && (_subscribers[i].context == context)){
+      // only mark while the subscribers are called (removed by <_event_call()>)
+      if(_subscriber_calls > 0){
+        _subscribers[i].callback = nullptr;
+        return true;
+      }
+
+      // remove (keep the order)
+      _subscriber_count--;
+      for(uint8_t j=i ; j < _subscriber_count ; j++){
+        _subscribers[j] = _subscribers[j + 1];
+      }
+      return true;
+    }
+  }
+#else
+  (void)callback;
+  (void)context;
+#endif
+  return false;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Read a parameter to the shadow (for <apply()>)
+//  @param (index) : the index of the parameter (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//  NOTE: the parameter is only read if it isn't in the shadow
+void SMW_SX1276M0::_apply_read(uint8_t index){
+  if(_shadow_valid & (1UL << index)){
+    return; // already known
+  }
+
+  // the getters update the shadow (only with a value in the response)
+  uint8_t value = 0;
+  switch(index){
+    case SMW_SX1276M0_SHADOW_ADR: { get_ADR(value); break; }
+    case SMW_SX1276M0_SHADOW_AJOIN: { get_AJoin(value); break; }
+    case SMW_SX1276M0_SHADOW_APPEUI: { char appeui[SMW_SX1276M0_SIZE_APPEUI]; get_AppEUI(appeui); break; }
+    case SMW_SX1276M0_SHADOW_APPKEY: { char appkey[SMW_SX1276M0_SIZE_APPKEY]; get_AppKey(appkey); break; }
+    case SMW_SX1276M0_SHADOW_APPSKEY: { char appskey[SMW_SX1276M0_SIZE_APPSKEY]; get_AppSKey(appskey); break; }
+    case SMW_SX1276M0_SHADOW_CONFIRMATION: { get_Confirmation(value); break; }
+    case SMW_SX1276M0_SHADOW_DEVADDR: { char devaddr[SMW_SX1276M0_SIZE_DEVADDR]; get_DevAddr(devaddr); break; }
+    case SMW_SX1276M0_SHADOW_DEVEUI: { char deveui[SMW_SX1276M0_SIZE_DEVEUI]; get_DevEUI(deveui); break; }
+    case SMW_SX1276M0_SHADOW_DR: { get_DR(value); break; }
+    case SMW_SX1276M0_SHADOW_ECHO: { get_Echo(value); break; }
+    case SMW_SX1276M0_SHADOW_JOIN_MODE: { get_JoinMode(value); break; }
+    case SMW_SX1276M0_SHADOW_NWKSKEY: { char nwkskey[SMW_SX1276M0_SIZE_NWKSKEY]; get_NwkSKey(nwkskey); break; }
+    case SMW_SX1276M0_SHADOW_P2P_DEVADDR: { char devaddr[SMW_SX1276M0_SIZE_DEVADDR]; get_P2P_DevAddr(devaddr); break; }
+    case SMW_SX1276M0_SHADOW_P2P_WORD: { get_P2P_SyncWord(value); break; }
+    case SMW_SX1276M0_SHADOW_REGION: { get_Region(value); break; }
+    case SMW_SX1276M0_SHADOW_RETRIES: { get_NumberOfRetries(value); break; }
+    case SMW_SX1276M0_SHADOW_TXP: { get_TXPower(value); break; }
+  }
+}
+
+// --------------------------------------------------
+
+// Get the value of a parameter of a configuration (for <apply()>)
+//  @param (config) : the configuration [SMW_SX1276M0_Config (&)]
+//         (index)  : the index of the parameter (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//         (value)  : the variable to store the value as in the shadow [uint32_t (&)]
+//         (key)    : the array to store the key, filtered as in the setters [char (&)[]]
+//  @returns false if the parameter is not set in the configuration [bool]
+bool SMW_SX1276M0::_apply_value(const SMW_SX1276M0_Config &config, uint8_t index, uint32_t &value, char (&key)[SMW_SX1276M0_SIZE_PARAMETER + 1]){
+  int16_t number = SMW_SX1276M0_CONFIG_UNSET;
+  const char *str = nullptr;
+  uint8_t size = 0;
+
+  switch(index){
+    case SMW_SX1276M0_SHADOW_ADR: {
+      if(config.adr != SMW_SX1276M0_CONFIG_UNSET){
+        number = (config.adr == SMW_SX1276M0_ADR_ON) ? SMW_SX1276M0_ADR_ON : SMW_SX1276M0_ADR_OFF; // as in <set_ADR()>
+      }
+      break;
+    }
+    case SMW_SX1276M0_SHADOW_AJOIN: {
+      if(config.ajoin != SMW_SX1276M0_CONFIG_UNSET){
+        number = (config.ajoin == SMW_SX1276M0_AUTOMATIC_JOIN_ON) ? SMW_SX1276M0_AUTOMATIC_JOIN_ON : SMW_SX1276M0_AUTOMATIC_JOIN_OFF; // as in <set_AJoin()>
+      }
+      break;
+    }
+    case SMW_SX1276M0_SHADOW_ECHO: {
+      if(config.echo != SMW_SX1276M0_CONFIG_UNSET){
+        number = (config.echo == SMW_SX1276M0_ECHO_ON) ? SMW_SX1276M0_ECHO_ON : SMW_SX1276M0_ECHO_OFF; // as in <set_Echo()>
+      }
+      break;
+    }
+    case SMW_SX1276M0_SHADOW_APPEUI: { str = config.appeui; size = SMW_SX1276M0_SIZE_APPEUI; break; }
+    case SMW_SX1276M0_SHADOW_APPKEY: { str = config.appkey; size = SMW_SX1276M0_SIZE_APPKEY; break; }
+    case SMW_SX1276M0_SHADOW_APPSKEY: { str = config.appskey; size = SMW_SX1276M0_SIZE_APPSKEY; break; }
+    case SMW_SX1276M0_SHADOW_CONFIRMATION: { number = config.confirmation; break; }
+    case SMW_SX1276M0_SHADOW_DEVADDR: { str = config.devaddr; size = SMW_SX1276M0_SIZE_DEVADDR; break; }
+    case SMW_SX1276M0_SHADOW_DEVEUI: { str = config.deveui; size = SMW_SX1276M0_SIZE_DEVEUI; break; }
+    case SMW_SX1276M0_SHADOW_DR: { number = config.dr; break; }
+    case SMW_SX1276M0_SHADOW_JOIN_MODE: { number = config.join_mode; break; }
+    case SMW_SX1276M0_SHADOW_NWKSKEY: { str = config.nwkskey; size = SMW_SX1276M0_SIZE_NWKSKEY; break; }
+    case SMW_SX1276M0_SHADOW_P2P_DEVADDR: { str = config.p2p_devaddr; size = SMW_SX1276M0_SIZE_DEVADDR; break; }
+    case SMW_SX1276M0_SHADOW_P2P_WORD: { number = config.p2p_sync_word; break; }
+    case SMW_SX1276M0_SHADOW_REGION: { number = config.region; break; }
+    case SMW_SX1276M0_SHADOW_RETRIES: { number = config.retries; break; }
+    case SMW_SX1276M0_SHADOW_TXP: { number = config.tx_power; break; }
+  }
+
+  // filter the string as in the setters
+  if(str){
+    key[size] = CHAR_EOS;
+    filter_string(key, size, str, FILTER_HEX);
+    return true;
+  }
+
+  if(number == SMW_SX1276M0_CONFIG_UNSET){
+    return false;
+  }
+  value = static_cast<uint32_t>(number);
+  return true;
+}
+
+// --------------------------------------------------
+
+// Write a parameter of a configuration (for <apply()>)
+//  @param (config) : the configuration [SMW_SX1276M0_Config (&)]
+//         (index)  : the index of the parameter (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//  @returns the type of the response [CommandResponse]
+//  NOTE: the numeric parameters out of range return ERROR (as in the setters)
+CommandResponse SMW_SX1276M0::_apply_write(const SMW_SX1276M0_Config &config, uint8_t index){
+  // check the range (the setters use 8 bits)
+  int16_t number = SMW_SX1276M0_CONFIG_UNSET;
+  switch(index){
+    case SMW_SX1276M0_SHADOW_CONFIRMATION: { number = config.confirmation; break; }
+    case SMW_SX1276M0_SHADOW_DR: { number = config.dr; break; }
+    case SMW_SX1276M0_SHADOW_JOIN_MODE: { number = config.join_mode; break; }
+    case SMW_SX1276M0_SHADOW_P2P_WORD: { number = config.p2p_sync_word; break; }
+    case SMW_SX1276M0_SHADOW_REGION: { number = config.region; break; }
+    case SMW_SX1276M0_SHADOW_RETRIES: { number = config.retries; break; }
+    case SMW_SX1276M0_SHADOW_TXP: { number = config.tx_power; break; }
+  }
+  if((number < SMW_SX1276M0_CONFIG_UNSET) || (number > UINT8_MAX)){
+    return CommandResponse::ERROR;
+  }
+
+  switch(index){
+    case SMW_SX1276M0_SHADOW_ADR: return set_ADR(config.adr);
+    case SMW_SX1276M0_SHADOW_AJOIN: return set_AJoin(config.ajoin);
+    case SMW_SX1276M0_SHADOW_APPEUI: return set_AppEUI(config.appeui);
+    case SMW_SX1276M0_SHADOW_APPKEY: return set_AppKey(config.appkey);
+    case SMW_SX1276M0_SHADOW_APPSKEY: return set_AppSKey(config.appskey);
+    case SMW_SX1276M0_SHADOW_CONFIRMATION: return set_Confirmation(config.confirmation);
+    case SMW_SX1276M0_SHADOW_DEVADDR: return set_DevAddr(config.devaddr);
+    case SMW_SX1276M0_SHADOW_DEVEUI: return set_DevEUI(config.deveui);
+    case SMW_SX1276M0_SHADOW_DR: return set_DR(config.dr);
+    case SMW_SX1276M0_SHADOW_ECHO: return set_Echo(config.echo);
+    case SMW_SX1276M0_SHADOW_JOIN_MODE: return set_JoinMode(config.join_mode);
+    case SMW_SX1276M0_SHADOW_NWKSKEY: return set_NwkSKey(config.nwkskey);
+    case SMW_SX1276M0_SHADOW_P2P_DEVADDR: return set_P2P_DevAddr(config.p2p_devaddr);
+    case SMW_SX1276M0_SHADOW_P2P_WORD: return set_P2P_SyncWord(config.p2p_sync_word);
+    case SMW_SX1276M0_SHADOW_REGION: return set_Region(config.region);
+    case SMW_SX1276M0_SHADOW_RETRIES: return set_NumberOfRetries(config.retries);
+    case SMW_SX1276M0_SHADOW_TXP: return set_TXPower(config.tx_power);
+  }
+  return CommandResponse::ERROR;
+}
+
+// --------------------------------------------------
+
+// Begin reading the response of a command
+//  @param (timeout) : the time to wait for the response in miliseconds [uint32_t]
+//         (async)   : true to call <response_listener> at the end [bool] (default: false)
+void SMW_SX1276M0::_begin_response(uint32_t timeout, bool async){
+  _buffer.reset(); // reset for storing the new response
+  _status.reset();
+  _response_status = 0; // reset
+  _response_line_start = true; // set
+  _command_start = millis();
+  _command_timeout = timeout;
+  _busy_async = async;
+  _busy = true; // set
+}
+
+// --------------------------------------------------
+
+// Decode an hexadecimal character of the payload
+//  @param (c) : the character to decode [uint8_t]
+void SMW_SX1276M0::_decode(uint8_t c){
+  if(_decode_state == SMW_SX1276M0_DECODE_ERROR){
+    return; // ignore the remaining data
+  }
+
+  // get the value
+  uint8_t value = hex_value(c);
+  if(value == 0xFF){
+    _decode_state = SMW_SX1276M0_DECODE_ERROR;
+    return;
+  }
+
+  // store the value
+  if(_decode_state == SMW_SX1276M0_DECODE_HIGH){
+    _decode_high = value << 4;
+    _decode_state = SMW_SX1276M0_DECODE_LOW;
+  } else {
+    if(_decode_length < _decode_size){
+      _decode_data[_decode_length++] = _decode_high | value;
+    } else {
+      _overflow++; // the byte is discarded
+    }
+    _decode_state = SMW_SX1276M0_DECODE_HIGH;
+  }
+}
+
+// --------------------------------------------------
+
+// Add a message to the tracker of confirmed messages
+//  @param (command) : the command to send (CMD_SEND or CMD_SENDB) [char *]
+//         (port)    : the application port [uint8_t]
+//         (data)    : the message [char *]
+//         (retries) : the maximum number of retries [uint8_t]
+//  @returns true if the message was added [bool]
+//  NOTE: the message isn't added if the uplink confirmation is off (it is read if unknown)
+bool SMW_SX1276M0::_confirmed_add(const char *command, uint8_t port, const char *data, uint8_t retries){
+#if SMW_SX1276M0_CONFIRMED_SIZE > 0
+  if(!data || (_confirmed_count >= SMW_SX1276M0_CONFIRMED_SIZE)){
+    return false;
+  }
+
+  // check the uplink confirmation
+  _apply_read(SMW_SX1276M0_SHADOW_CONFIRMATION);
+  if(!(_shadow_valid & (1UL << SMW_SX1276M0_SHADOW_CONFIRMATION)) || (_shadow[SMW_SX1276M0_SHADOW_CONFIRMATION] != 1)){
+    return false;
+  }
+
+  ConfirmedUplink &entry = _confirmed[_confirmed_count++];
+  entry.report.data = data;
+  entry.report.port = port;
+  entry.report.state = ConfirmedState::PENDING;
+  entry.report.attempts = 0;
+  entry.report.latency = 0;
+  entry.command = command;
+  entry.retries = retries;
+  entry.queued = false;
+  entry.time = 0;
+  entry.backoff = 0;
+  return true;
+#else
+  (void)command;
+  (void)port;
+  (void)data;
+  (void)retries;
+  return false; // (no table)
+#endif
+}
+
+// --------------------------------------------------
+
+// Update the tracker of confirmed messages
+//  NOTE: the messages are sent in order, one at a time, through the queue of commands
+//  NOTE: a message is acknowledged if the module replies OK to the send (so
+//        the uplink confirmation must be enabled with <set_Confirmation()>,
+//        otherwise the message fails), else it is sent again after an
+//        exponential backoff
+//  NOTE: the result is given by the ACKNOWLEDGED or NOT_ACKNOWLEDGED event
+//        (see <get_ConfirmedReport()>)
+void SMW_SX1276M0::_confirmed_process(void){
+#if SMW_SX1276M0_CONFIRMED_SIZE > 0
+  if(_confirmed_count == 0){
+    return;
+  }
+  ConfirmedUplink &entry = _confirmed[0]; // (the oldest)
+  if(entry.queued || ((millis() - entry.time) < entry.backoff)){
+    return;
+  }
+
+  if(_enqueue(SMW_SX1276M0_QUEUE_SEND_CONFIRMED, entry.command, nullptr, entry.report.port, entry.report.data, _confirmed_result, this)){
+    entry.queued = true; // set
+  }
+#endif
+}
+
+// --------------------------------------------------
+
+// Handle the responses of the tracker of confirmed messages
+//  @param (result) : the result of the command [CommandResult (&)]
+void SMW_SX1276M0::_confirmed_result(CommandResult &result){
+#if SMW_SX1276M0_CONFIRMED_SIZE > 0
+  SMW_SX1276M0 *lorawan = static_cast<SMW_SX1276M0 *>(result.context);
+  ConfirmedUplink &entry = lorawan->_confirmed[0];
+  uint32_t now = millis();
+  entry.queued = false; // reset
+
+  // check if the message was sent
+  if(result.response == CommandResponse::DUTY_CYCLE){
+    entry.time = now;
+    entry.backoff = lorawan->get_UplinkWait();
+    return; // not an attempt
+  }
+  if(entry.report.attempts == 0){
+    entry.first = now;
+  }
+  entry.report.attempts++;
+  entry.report.latency = now - entry.first;
+
+  // check the acknowledgement
+  //  NOTE: an OK without the uplink confirmation isn't an acknowledgement
+  //        (the mode might have been changed after the message was added)
+  const uint32_t confirmation = 1UL << SMW_SX1276M0_SHADOW_CONFIRMATION;
+  bool confirmed = ((lorawan->_shadow_valid & confirmation) == 0) || (lorawan->_shadow[SMW_SX1276M0_SHADOW_CONFIRMATION] == 1);
+  if((result.response == CommandResponse::OK) && confirmed){
+    entry.report.state = ConfirmedState::ACKED;
+    lorawan->_confirmed_acked++;
+  } else if((result.response == CommandResponse::OK) || (result.response == CommandResponse::TOO_LONG) || (entry.report.attempts > entry.retries)){
+    entry.report.state = ConfirmedState::FAILED;
+    lorawan->_confirmed_failed++;
+  } else {
+    entry.backoff = backoff_time(entry.report.attempts, SMW_SX1276M0_CONFIRMED_BACKOFF_MIN, SMW_SX1276M0_CONFIRMED_BACKOFF_MAX);
+    entry.time = now;
+#ifdef SMW_SX1276M0_DEBUG
+    if(lorawan->_stream_debug){
+      lorawan->_stream_debug->print(F("Retry:")); // DEBUG
+      lorawan->_stream_debug->println(entry.backoff); // DEBUG
+    }
+#endif
+    return;
+  }
+
+  // remove from the tracker (keep the order)
+  uint16_t length = payload_length(entry.command, entry.report.data);
+  lorawan->_confirmed_last = entry.report;
+  lorawan->_confirmed_count--;
+  for(uint8_t i=0 ; i < lorawan->_confirmed_count ; i++){
+    lorawan->_confirmed[i] = lorawan->_confirmed[i + 1];
+  }
+
+  // call the event
+  Event event = (lorawan->_confirmed_last.state == ConfirmedState::ACKED) ? Event::ACKNOWLEDGED : Event::NOT_ACKNOWLEDGED;
+  lorawan->_event_call(event, now, lorawan->_confirmed_last.port, length);
+#else
+  (void)result;
+#endif
+}
+
+// --------------------------------------------------
+
+// Custom delay in miliseconds
+//  @param (duration) : the duration of the delay in miliseconds [uint32_t]
+void SMW_SX1276M0::_delay(uint32_t duration){
+  uint32_t stop_time = millis() + duration;
+  while(millis() < stop_time){
+#if defined(ARDUINO_ESP8266_GENERIC) || defined(ARDUINO_ESP8266_NODEMCU) || defined(ARDUINO_ESP8266_THING) || defined(ARDUINO_ESP32_DEV)
+// ESP8266 Generic / NodeMCU / Sparkfun The Thing / ESP32 Dev
+    yield(); // custom function for a non blocking execution with the ESP family
+#else
+    // do nothing
+#endif
+  }
+}
+
+// --------------------------------------------------
+
+// Read a downlink and call the handler of its port
+//  @param (event) : the event received (RECEIVED or RECEIVED_X) [Event]
+//         (port)  : the application port of the event [uint8_t]
+//  NOTE: the message is read only if a handler will receive it (otherwise
+//        it is left in the module for the events)
+void SMW_SX1276M0::_downlink_dispatch(Event event, uint8_t port){
+  if(!_default_handler && ((_port_handler_count == 0) || (_port_find(port) < 0))){
+    return;
+  }
+
+  // read the message
+  Downlink downlink;
+  downlink.hex = (event == Event::RECEIVED_X);
+  CommandResponse res = downlink.hex ? readX(downlink.port, downlink.payload) : readT(downlink.port, downlink.payload);
+  if((res != CommandResponse::OK) || !downlink.payload.data){
+    return;
+  }
+
+  // decode the hexadecimal data in place (the view points to the buffer)
+  //  NOTE: each byte is stored before the characters still to decode
+  if(downlink.hex){
+    uint8_t *data = const_cast<uint8_t *>(downlink.payload.data);
+    _decode_data = data;
+    _decode_size = downlink.payload.length / 2;
+    _decode_length = 0;
+    _decode_state = SMW_SX1276M0_DECODE_HIGH;
+    for(uint16_t i=0 ; i < downlink.payload.length ; i++){
+      _decode(data[i]);
+    }
+    bool valid = (_decode_state == SMW_SX1276M0_DECODE_HIGH); // (not an odd number of characters or an error)
+    _decode_state = SMW_SX1276M0_DECODE_OFF; // reset
+    if(!valid){
+      return; // malformed data
+    }
+    downlink.payload.length = _decode_length;
+  }
+
+  // call the handler
+#if SMW_SX1276M0_PORT_HANDLERS_SIZE > 0
+  int8_t index = _port_find(downlink.port);
+  if(index >= 0){
+    downlink.context = _port_handlers[index].context;
+    _port_handlers[index].callback(downlink);
+    return;
+  }
+#endif
+  if(_default_handler){
+    downlink.context = _default_context;
+    _default_handler(downlink);
+  }
+}
+
+// --------------------------------------------------
+
+// Call an event (<event_listener> and the subscribers)
+//  @param (event)      : the event [Event]
+//         (time)       : the time the event was received [ms] [uint32_t]
+//         (port)       : the application port (if any) [uint8_t]
+//         (length)     : the length of the payload (if any) [uint16_t]
+//         (call_event) : true to call the event [bool] (default: true)
+//  NOTE: no allocation, the data is given by reference to the subscribers
+void SMW_SX1276M0::_event_call(Event event, uint32_t time, uint8_t port, uint16_t length, bool call_event){
+  _event_time = time; // update
+  if(!call_event){
+    return;
+  }
+
+  // read the downlink for the handlers of the ports
+  if((event == Event::RECEIVED) || (event == Event::RECEIVED_X)){
+    _downlink_dispatch(event, port);
+  }
+
+  if(event_listener){
+    event_listener(event);
+  }
+
+#if SMW_SX1276M0_SUBSCRIBERS_SIZE > 0
+  // call the subscribers (the ones added by the callbacks receive only the next events)
+  EventInfo info = { event , time , port , length , nullptr };
+  uint16_t bit = SMW_SX1276M0_EVENT_MASK(event);
+  uint8_t count = _subscriber_count;
+  _subscriber_calls++;
+  for(uint8_t i=0 ; i < count ; i++){
+    if(_subscribers[i].callback && (_subscribers[i].mask & bit)){
+      info.context = _subscribers[i].context;
+      _subscribers[i].callback(info);
+    }
+  }
+  _subscriber_calls--;
+
+  // remove the subscribers that unsubscribed during the calls (keep the order)
+  if(_subscriber_calls == 0){
+    uint8_t j = 0;
+    for(uint8_t i=0 ; i < _subscriber_count ; i++){
+      if(_subscribers[i].callback){
+        _subscribers[j++] = _subscribers[i];
+      }
+    }
+    _subscriber_count = j;
+  }
+#else
+  (void)port;
+  (void)length;
+#endif
+}
+
+// --------------------------------------------------
+
+// Call the events received during the commands
+//  @param (call_event) : true to call the events (otherwise they are discarded) [bool]
+//  @returns the number of events [uint8_t]
+uint8_t SMW_SX1276M0::_event_deliver(bool call_event){
+  uint8_t count = 0;
+#if SMW_SX1276M0_EVENT_QUEUE_SIZE > 0
+  while(_event_count > 0){
+    QueuedEvent entry = _events[_event_head];
+    _event_head = (_event_head + 1) % SMW_SX1276M0_EVENT_QUEUE_SIZE;
+    _event_count--;
+
+    _event_call(entry.event, entry.time, entry.port, entry.length, call_event); // (it might send commands and queue more events)
+    count++;
+  }
+#else
+  (void)call_event;
+#endif
+  return count;
+}
+
+// --------------------------------------------------
+
+// Add an event to the queue
+//  @param (event)  : the event received [Event]
+//         (port)   : the application port (if any) [uint8_t]
+//         (length) : the length of the payload (if any) [uint16_t]
+//  NOTE: the oldest event is discarded if the queue is full (see <get_EventsDropped()>)
+void SMW_SX1276M0::_event_push(Event event, uint8_t port, uint16_t length){
+#if SMW_SX1276M0_EVENT_QUEUE_SIZE > 0
+  if(_event_count >= SMW_SX1276M0_EVENT_QUEUE_SIZE){
+    _event_head = (_event_head + 1) % SMW_SX1276M0_EVENT_QUEUE_SIZE;
+    _event_count--;
+    _events_dropped++; // the event is discarded
+  }
+
+  QueuedEvent &entry = _events[(_event_head + _event_count) % SMW_SX1276M0_EVENT_QUEUE_SIZE];
+  entry.event = event;
+  entry.time = millis();
+  entry.port = port;
+  entry.length = length;
+  _event_count++;
+#else
+  (void)event;
+  (void)port;
+  (void)length;
+  _events_dropped++; // (no queue)
+#endif
+}
+
+// --------------------------------------------------
+
+// Update the state with an unsolicited line
+//  @param (tokens) : the tokens found in the line (bit mask) [uint8_t]
+//         (type)   : the character after the RECV token (if any) [uint8_t]
+//         (event)  : the variable to store the event [Event (&)]
+//  @returns true if the line is an event [bool]
+bool SMW_SX1276M0::_event_state(uint8_t tokens, uint8_t type, Event &event){
+  // check for the event header
+  if(tokens & (1 << SMW_SX1276M0_TOKEN_EVENT)){
+    // check for sleep
+    if(tokens & (1 << SMW_SX1276M0_TOKEN_SLEEP)){
+#ifdef SMW_SX1276M0_DEBUG
+      if(_stream_debug){
+        _stream_debug->println(F("Found S")); // DEBUG
+      }
+#endif
+      _sleeping = true; // set
+      event = Event::SLEEP;
+      return true;
+    }
+
+    // check for join
+    if(tokens & (1 << SMW_SX1276M0_TOKEN_JOINED)){
+#ifdef SMW_SX1276M0_DEBUG
+      if(_stream_debug){
+        _stream_debug->println(F("Found J")); // DEBUG
+      }
+#endif
+      _connected = true; // set
+      event = Event::JOINED;
+      return true;
+    }
+
+    // check for received message
+    if(tokens & (1 << SMW_SX1276M0_TOKEN_RECV)){
+#ifdef SMW_SX1276M0_DEBUG
+      if(_stream_debug){
+        _stream_debug->print(F("Found M:")); // DEBUG
+        _stream_debug->println(type, HEX); // DEBUG
+      }
+#endif
+      if(type == CHAR_SPACE){
+        event = Event::RECEIVED;
+      } else if(type == 'B'){
+        event = Event::RECEIVED_X;
+      } else {
+        return false; // wrong type
+      }
+      return true;
+    }
+  }
+
+  // check for the reset header
+  if(tokens & (1 << SMW_SX1276M0_TOKEN_BOOT)){
+#ifdef SMW_SX1276M0_DEBUG
+    if(_stream_debug){
+      _stream_debug->println(F("Found R")); // DEBUG
+    }
+#endif
+    _connected = false; // reset
+    _shadow_valid = 0; // the configuration must be read again
+    _uplink_dr = SMW_SX1276M0_UPLINK_DR_UNKNOWN;
+
+    // check if the module was sleeping
+    if(_sleeping){
+      _sleeping = false; // reset
+      // NOTE: the wakeup reset could be done with "Wakeup by RTC", but
+      //       the reset of the module already means it has awoken.
+      event = Event::WAKEUP;
+    } else {
+      _reset = true; // set
+      event = Event::RESET; // simple reset
+    }
+    return true;
+  }
+
+  return false;
+}
+
+// --------------------------------------------------
+
+// Add a command to the queue
+//  @param (type)      : the type of the command [uint8_t]
+//         (command)   : the command to send [char *]
+//         (parameter) : the parameter to copy (if any) [char *]
+//         (port)      : the application port (for messages) [uint8_t]
+//         (data)      : the message (for messages) [char *]
+//         (callback)  : the function to call with the result [CommandCallback]
+//         (context)   : the context for the callback [void *]
+//  @returns true if the command was queued [bool]
+bool SMW_SX1276M0::_enqueue(uint8_t type, const char *command, const char *parameter, uint8_t port, const char *data, CommandCallback callback, void *context){
+  if(!command || (_queue_count >= SMW_SX1276M0_QUEUE_SIZE)){
+    return false;
+  }
+
+  QueuedCommand &entry = _queue[(_queue_head + _queue_count) % SMW_SX1276M0_QUEUE_SIZE];
+  entry.type = type;
+  entry.command = command;
+  entry.parameter[0] = CHAR_EOS;
+  if(parameter){
+    strncpy(entry.parameter, parameter, SMW_SX1276M0_SIZE_PARAMETER);
+    entry.parameter[SMW_SX1276M0_SIZE_PARAMETER] = CHAR_EOS;
+  }
+  entry.port = port;
+  entry.data = data;
+  entry.callback = callback;
+  entry.context = context;
+  _queue_count++;
+
+  return true;
+}
+
+// --------------------------------------------------
+
+// Finish reading the response of a command and interpret its status
+void SMW_SX1276M0::_finish_response(void){
+  _response_time = millis() - _command_start; // update
+  _busy = false; // reset
+  _overflow += _buffer.overflow() + _status.overflow(); // update
+
+  // stop decoding (only the response to <readX()> is decoded)
+  if(_decode_state == SMW_SX1276M0_DECODE_LOW){
+    _decode_state = SMW_SX1276M0_DECODE_ERROR; // odd number of characters
+  } else if(_decode_state != SMW_SX1276M0_DECODE_ERROR){
+    _decode_state = SMW_SX1276M0_DECODE_OFF;
+  }
+
+  CommandResponse res = CommandResponse::ERROR; // default value is wrong result
+  uint16_t data_length = _status.available();
+  
+#ifdef SMW_SX1276M0_DEBUG
+  // debug
+  if(_stream_debug){
+    _status.print(_stream_debug);
+  }
+#endif
+
+  // interpret the data (only if a status was received)
+  if((_response_status != 0) && (data_length > 0)){
+    // get a copy of the buffer
+    uint8_t data[data_length];
+    _status.copy(data);
+    
+    // check for OK
+    if(memcmp(data, RSPNS_OK, strlen(RSPNS_OK)) == 0){
+      res = CommandResponse::OK;
+    } else if(memmem(data, data_length, RSPNS_FAILED, strlen(RSPNS_FAILED))){
+      // check for FAILED
+      if(data_length > strlen(RSPNS_FAILED)){
+        // at this time, doesn't store the message of the response
+        res = CommandResponse::FAILED_STRING;
+      } else {
+        res = CommandResponse::FAILED;
+      }
+    } else if(memmem(data, data_length, RSPNS_NOT_FOUND, strlen(RSPNS_NOT_FOUND))){
+      // check for NOT FOUND
+      if(data_length == (strlen(RSPNS_NOT_FOUND) + 12)){
+        res = CommandResponse::NOT_FOUND;
+      }
+    }
+  }
+  _last_response = res; // update
+
+  // register the uplink
+  if(_uplink_pending){
+    _uplink_pending = false; // reset
+    if(res == CommandResponse::OK){
+      _uplink_register(_uplink_length);
+    }
+  }
+
+  // check for a queued command
+  if(_queue_active){
+    _finish_queued(res);
+    return;
+  }
+
+  // call the listener
+  if(_busy_async && response_listener){
+    response_listener(res);
+  }
+}
+
+// --------------------------------------------------
+
+// Finish the active queued command
+//  @param (res) : the response of the command [CommandResponse]
+void SMW_SX1276M0::_finish_queued(CommandResponse res){
+  const QueuedCommand &entry = _queue[_queue_head];
+  CommandResult result = { entry.command, res, 0, &_buffer, entry.context };
+  CommandCallback callback = entry.callback;
+
+  // parse the numeric value of a query
+  if((entry.type == SMW_SX1276M0_QUEUE_GET) && (res == CommandResponse::OK)){
+    bool negative = false;
+    bool digits = false;
+    for(uint16_t i=0 ; i < _buffer.available() ; i++){
+      uint8_t c = _buffer[i];
+      if(isdigit(c)){
+        result.value = (result.value * 10) + (c - '0');
+        digits = true; // set
+      } else if(digits){
+        break; // end of the number
+      } else if(c == '-'){
+        negative = true;
+      }
+    }
+    if(negative){
+      result.value = -result.value;
+    }
+  }
+
+  // remove from the queue
+  _queue_active = false; // reset
+  _queue_head = (_queue_head + 1) % SMW_SX1276M0_QUEUE_SIZE;
+  _queue_count--;
+
+  // call the callback and send the next command right away
+  if(callback){
+    callback(result);
+  }
+  _issue_queued();
+}
+
+// --------------------------------------------------
+
+// Format the application port for a message (<port>:)
+//  @param (port)  : the application port [uint8_t]
+//         (sport) : the array to store the result [char[5]]
+void SMW_SX1276M0::_format_port(uint8_t port, char (&sport)[5]){
+  // parse the port
+  uint8_t aport = port; // auxiliary variable for <port>
+  uint8_t temp[3];
+
+  temp[0] = aport / 100;
+  aport %= 100;
+  temp[1] = aport / 10;
+  temp[2] = aport % 10;
+
+  // set the header (port)
+  uint8_t index = 0;
+  aport = 0; // reset
+  for(uint8_t i=0 ; i < 3 ; i++){
+    if((temp[i] > 0) || (aport > 0)){
+      sport[index++] = temp[i] + '0'; // convert to ASCII character
+    }
+    aport += temp[i]; // update (simple)
+  }
+  sport[index++] = CHAR_COLON;
+  sport[index] = CHAR_EOS;
+}
+
+// --------------------------------------------------
+
+// Send the next queued command, if the module is free
+void SMW_SX1276M0::_issue_queued(void){
+  if(_busy || _queue_active || (_queue_count == 0)){
+    return;
+  }
+
+  const QueuedCommand &entry = _queue[_queue_head];
+  uint32_t timeout = (entry.type == SMW_SX1276M0_QUEUE_SEND_CONFIRMED) ? SMW_SX1276M0_TIMEOUT_WRITE_CONFIRMED : SMW_SX1276M0_TIMEOUT_WRITE;
+  if(entry.type == SMW_SX1276M0_QUEUE_GET){
+    _send_command(entry.command);
+    if((strcmp(entry.command, CMD_RECV) == 0) || (strcmp(entry.command, CMD_RECVB) == 0)){
+      timeout = SMW_SX1276M0_TIMEOUT_READ_DOWNLINK;
+    } else {
+      timeout = SMW_SX1276M0_TIMEOUT_READ;
+    }
+  } else if(entry.type == SMW_SX1276M0_QUEUE_SET){
+    _send_command(entry.command, 1, entry.parameter);
+  } else {
+    // check the uplink
+    CommandResponse res = _uplink_check(payload_length(entry.command, entry.data), false);
+    if(res != CommandResponse::OK){
+      _queue_active = true; // set
+      _buffer.reset(); // no data
+      _finish_queued(res);
+      return;
+    }
+
+    _send_payload(entry.command, entry.port, entry.data);
+  }
+
+  _queue_active = true; // set
+  _begin_response(timeout);
+}
+
+// --------------------------------------------------
+
+// Calculate the next backoff of the join
+//  NOTE: see <backoff_time()>
+void SMW_SX1276M0::_join_backoff_next(void){
+  _join_backoff = backoff_time(_join_attempts, SMW_SX1276M0_JOIN_BACKOFF_MIN, SMW_SX1276M0_JOIN_BACKOFF_MAX);
+  _join_time = millis(); // update
+  _join_step = SMW_SX1276M0_JOIN_STEP_BACKOFF;
+
+#ifdef SMW_SX1276M0_DEBUG
+  if(_stream_debug){
+    _stream_debug->print(F("Backoff:")); // DEBUG
+    _stream_debug->println(_join_backoff); // DEBUG
+  }
+#endif
+}
+
+// --------------------------------------------------
+
+// Update the join started with <join_async()>
+void SMW_SX1276M0::_join_process(void){
+  // check for a lost session
+  if((_join_state == JoinState::JOINED) && !_connected){
+    _join_state = JoinState::IDLE;
+    return;
+  }
+  if(_join_state != JoinState::JOINING){
+    return;
+  }
+
+  // check for the end
+  if(_connected){
+    _join_state = JoinState::JOINED;
+    return;
+  }
+  uint32_t now = millis();
+  if((now - _join_start) >= _join_deadline){
+    _join_state = JoinState::FAILED;
+    return;
+  }
+
+  switch(_join_step){
+    case SMW_SX1276M0_JOIN_STEP_SEND: {
+      if(enqueue_get(CMD_JOIN, _join_result, this)){
+        _join_attempts++;
+        _join_step = SMW_SX1276M0_JOIN_STEP_REQUEST;
+      }
+      break;
+    }
+
+    case SMW_SX1276M0_JOIN_STEP_WAIT: {
+      // check the join status if the event didn't arrive
+      if(((now - _join_time) >= SMW_SX1276M0_TIMEOUT_JOIN_ATTEMPT) && enqueue_get(CMD_NJS, _join_result, this)){
+        _join_step = SMW_SX1276M0_JOIN_STEP_STATUS;
+      }
+      break;
+    }
+
+    case SMW_SX1276M0_JOIN_STEP_BACKOFF: {
+      if((now - _join_time) >= _join_backoff){
+        _join_step = SMW_SX1276M0_JOIN_STEP_SEND;
+      }
+      break;
+    }
+
+    default: {
+      break; // waiting for a response
+    }
+  }
+}
+
+// --------------------------------------------------
+
+// Handle the responses of the join manager
+//  @param (result) : the result of the command [CommandResult (&)]
+void SMW_SX1276M0::_join_result(CommandResult &result){
+  SMW_SX1276M0 *lorawan = static_cast<SMW_SX1276M0 *>(result.context);
+  if(lorawan->_join_state != JoinState::JOINING){
+    return; // ignore
+  }
+
+  // check the request
+  if(result.command == CMD_JOIN){
+    if(result.response == CommandResponse::OK){
+      lorawan->_join_time = millis(); // update
+      lorawan->_join_step = SMW_SX1276M0_JOIN_STEP_WAIT;
+    } else {
+      lorawan->_join_backoff_next();
+    }
+    return;
+  }
+
+  // check the status (fallback for a lost event)
+  if((result.response == CommandResponse::OK) && (result.value == SMW_SX1276M0_JOIN_STATUS_JOINED)){
+    if(!lorawan->_connected){
+      lorawan->_connected = true; // set
+      lorawan->_event_call(Event::JOINED, millis(), 0, 0);
+    }
+    lorawan->_join_state = JoinState::JOINED;
+  } else {
+    lorawan->_join_backoff_next();
+  }
+}
+
+// --------------------------------------------------
+
+// Check if an uplink is allowed
+//  @param (length)   : the length of the application payload in bytes [uint16_t]
+//         (blocking) : true to read the data rate again if needed (only in the synchronous commands) [bool]
+//  @returns OK if allowed, TOO_LONG or DUTY_CYCLE [CommandResponse]
+//  NOTE: the length is checked only if the region and the data rate are known
+//  NOTE: with the ADR, the length is checked with the data rate of the last uplink, which
+//        is read again only if the payload is too long for it (and <blocking> is set)
+CommandResponse SMW_SX1276M0::_uplink_check(uint16_t length, bool blocking){
+  // check the maximum payload
+  uint8_t region, dr;
+  if(_uplink_settings(region, dr)){
+    uint8_t max_length = ::max_payload(region, dr);
+    if((max_length > 0) && (length > max_length) && blocking && !(_shadow_valid & (1UL << SMW_SX1276M0_SHADOW_DR))){
+      // the ADR might have changed the data rate since the last uplink
+      _apply_read(SMW_SX1276M0_SHADOW_DR);
+      if(_uplink_settings(region, dr)){
+        max_length = ::max_payload(region, dr);
+      }
+    }
+    if((max_length > 0) && (length > max_length)){
+#ifdef SMW_SX1276M0_DEBUG
+      if(_stream_debug){
+        _stream_debug->println(F("Too long")); // DEBUG
+      }
+#endif
+      return CommandResponse::TOO_LONG;
+    }
+  }
+
+  // check the duty cycle
+  if(_uplink_gate && (get_UplinkWait() > 0)){
+#ifdef SMW_SX1276M0_DEBUG
+    if(_stream_debug){
+      _stream_debug->println(F("Duty cycle")); // DEBUG
+    }
+#endif
+    return CommandResponse::DUTY_CYCLE;
+  }
+  return CommandResponse::OK;
+}
+
+// --------------------------------------------------
+
+// Get the parameters of the current data rate
+//  @param (sf)        : the variable to store the spreading factor (0 for FSK) [uint8_t (&)]
+//         (bandwidth) : the variable to store the bandwidth in kHz [uint16_t (&)]
+//  @returns false if the region or the data rate is unknown [bool]
+//  NOTE: the values are taken from <_uplink_settings()>
+bool SMW_SX1276M0::_uplink_datarate(uint8_t &sf, uint16_t &bandwidth){
+  uint8_t region, dr;
+  if(!_uplink_settings(region, dr) || (region >= SMW_SX1276M0_REGION_COUNT) || (dr > 7)){
+    return false;
+  }
+
+  uint8_t table = pgm_read_byte(&REGIONS[region].data_rates);
+  uint8_t parameters = pgm_read_byte(&DATA_RATES[table][dr]);
+  if((parameters == SMW_SX1276M0_DR_NONE) || (::max_payload(region, dr) == 0)){
+    return false; // (not defined in the region)
+  }
+
+  sf = parameters & 0x0F;
+  bandwidth = 125 << (parameters >> 4);
+  return true;
+}
+
+// --------------------------------------------------
+
+// Get the region and the data rate of the uplinks
+//  @param (region) : the variable to store the region [uint8_t (&)]
+//         (dr)     : the variable to store the data rate [uint8_t (&)]
+//  @returns false if the region or the data rate is unknown [bool]
+//  NOTE: the values are taken from the shadow of the configuration, except
+//        with the ADR, when the data rate of the last uplink is kept until
+//        the data rate is read again (see <_uplink_register()>)
+bool SMW_SX1276M0::_uplink_settings(uint8_t &region, uint8_t &dr){
+  if(!(_shadow_valid & (1UL << SMW_SX1276M0_SHADOW_REGION))){
+    return false;
+  }
+  region = _shadow[SMW_SX1276M0_SHADOW_REGION];
+
+  if(_shadow_valid & (1UL << SMW_SX1276M0_SHADOW_DR)){
+    dr = _shadow[SMW_SX1276M0_SHADOW_DR];
+  } else if(_uplink_dr != SMW_SX1276M0_UPLINK_DR_UNKNOWN){
+    dr = _uplink_dr; // (the last known)
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// --------------------------------------------------
+
+// Register an uplink in the duty cycle
+//  @param (length) : the length of the application payload in bytes [uint16_t]
+//  NOTE: the off time starts at the end of the command (conservative)
+void SMW_SX1276M0::_uplink_register(uint16_t length){
+  uint32_t toa = get_TimeOnAir(length); // [us]
+
+  // the ADR can change the data rate and the transmission power in the downlinks
+  if((_shadow_valid & (1UL << SMW_SX1276M0_SHADOW_ADR)) && (_shadow[SMW_SX1276M0_SHADOW_ADR] == SMW_SX1276M0_ADR_OFF)){
+    // the data rate and the power are fixed
+  } else {
+    // keep the last data rate for the checks of the uplinks (read again only when needed, see <_uplink_check()>)
+    if(_shadow_valid & (1UL << SMW_SX1276M0_SHADOW_DR)){
+      _uplink_dr = _shadow[SMW_SX1276M0_SHADOW_DR];
+    }
+    _shadow_valid &= ~((1UL << SMW_SX1276M0_SHADOW_DR) | (1UL << SMW_SX1276M0_SHADOW_TXP));
+  }
+
+  if(toa == 0){
+    return; // unknown
+  }
+  uint16_t duty_cycle = pgm_read_word(&REGIONS[_shadow[SMW_SX1276M0_SHADOW_REGION]].duty_cycle);
+  if(duty_cycle == 0){
+    return; // no limit
+  }
+
+  // accumulate the off time
+  uint32_t off = ((toa + 999) / 1000) * (duty_cycle - 1); // [ms]
+  _uplink_off = get_UplinkWait() + off;
+  _uplink_start = millis();
+
+#ifdef SMW_SX1276M0_DEBUG
+  if(_stream_debug){
+    _stream_debug->print(F("Off:")); // DEBUG
+    _stream_debug->println(_uplink_off); // DEBUG
+  }
+#endif
+}
+
+// --------------------------------------------------
+
+// Match the tokens of the unsolicited lines, one byte at a time
+//  @param (c) : the byte received [uint8_t]
+//  NOTE: all the tokens are checked in a single pass, without storing the line,
+//        with one step of the automaton per byte (see <MATCHER>)
+void SMW_SX1276M0::_match_tokens(uint8_t c){
+  uint8_t character = (c < SMW_SX1276M0_MATCHER_BYTES) ? pgm_read_byte(&MATCHER.classes[c]) : 0;
+  _token_state = pgm_read_byte(&MATCHER.states[_token_state].next[character]);
+
+  uint8_t found = pgm_read_byte(&MATCHER.found[_token_state]) & ~_tokens; // (only the first occurrence is relevant)
+  if(found){
+    _tokens |= found;
+    if(found & (1 << SMW_SX1276M0_TOKEN_RECV)){
+      _token_recv_end = _line.available() + 1; // (the byte is not stored yet)
+    }
+  }
+}
+
+// --------------------------------------------------
+
+// Check if a parameter is stored in the shadow
+//  @param (index) : the index of the parameter (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//         (value) : the value to check [uint32_t]
+//  @returns true if the module already has the value [bool]
+bool SMW_SX1276M0::_shadow_check(uint8_t index, uint32_t value){
+  if((_shadow_valid & (1UL << index)) && (_shadow[index] == value)){
+#ifdef SMW_SX1276M0_DEBUG
+    if(_stream_debug){
+      _stream_debug->print(F("Shadow:")); // DEBUG
+      _stream_debug->println(index); // DEBUG
+    }
+#endif
+    return true;
+  }
+  return false;
+}
+
+// --------------------------------------------------
+
+// Check if a key is stored in the shadow
+//  @param (index) : the index of the key (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//         (key)   : the key to check (hexadecimal) [char *]
+//  @returns true if the module already has the key [bool]
+//  NOTE: the keys are compared byte by byte, so a different key is always written
+bool SMW_SX1276M0::_shadow_check(uint8_t index, const char *key){
+  uint8_t data[SMW_SX1276M0_SIZE_PARAMETER / 2];
+  uint8_t size = decode_key(index, key, data);
+  if((size > 0) && (_shadow_valid & (1UL << index)) && (memcmp(&_shadow_keys[pgm_read_byte(&SHADOW_KEYS[index].offset)], data, size) == 0)){
+#ifdef SMW_SX1276M0_DEBUG
+    if(_stream_debug){
+      _stream_debug->print(F("Shadow:")); // DEBUG
+      _stream_debug->println(index); // DEBUG
+    }
+#endif
+    return true;
+  }
+  return false;
+}
+
+// --------------------------------------------------
+
+// Update a parameter in the shadow
+//  @param (index) : the index of the parameter (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//         (value) : the value of the parameter [uint32_t]
+//         (res)   : the response of the module [CommandResponse]
+//  NOTE: the parameter is invalidated if the response is not OK
+void SMW_SX1276M0::_shadow_update(uint8_t index, uint32_t value, CommandResponse res){
+  if(res == CommandResponse::OK){
+    _shadow[index] = value;
+    _shadow_valid |= (1UL << index);
+  } else {
+    _shadow_valid &= ~(1UL << index);
+  }
+}
+
+// --------------------------------------------------
+
+// Update a key in the shadow
+//  @param (index) : the index of the key (SMW_SX1276M0_SHADOW_*) [uint8_t]
+//         (key)   : the key (hexadecimal) [char *]
+//         (res)   : the response of the module [CommandResponse]
+//  NOTE: the key is invalidated if the response is not OK or if the key is not complete
+void SMW_SX1276M0::_shadow_update(uint8_t index, const char *key, CommandResponse res){
+  uint8_t data[SMW_SX1276M0_SIZE_PARAMETER / 2];
+  uint8_t size = decode_key(index, key, data);
+  if((res == CommandResponse::OK) && (size > 0)){
+    memcpy(&_shadow_keys[pgm_read_byte(&SHADOW_KEYS[index].offset)], data, size);
+    _shadow_valid |= (1UL << index);
+  } else {
+    _shadow_valid &= ~(1UL << index);
+  }
+}
+
+// --------------------------------------------------
+
+// Parse an incoming byte
+//  @param (c) : the byte received [uint8_t]
+//  @returns true if a line was completed and must be processed [bool]
+bool SMW_SX1276M0::_parse(uint8_t c){
+#ifdef SMW_SX1276M0_DEBUG
+  // debug
+  if(_stream_debug){
+    if(c > 32){
+      _stream_debug->write(c);
+    } else {
+      _stream_debug->print('(');
+      _stream_debug->print(c, HEX);
+      _stream_debug->print(')');
+    }
+  }
+#endif
+
+  bool eol = ((c == 0) || (c == CHAR_LF) || (c == CHAR_CR));
+
+  // check for a pending command
+  if(_busy){
+    // keep the unsolicited lines apart from the response (they start with the event header or with the boot banner)
+    if((_line.available() == 0) && (!_response_line_start || ((c != RSPNS_EVENT[0]) && (c != RSPNS_BOOT[0])))){
+      _response_line_start = eol;
+      _parse_response(c);
+      return false;
+    }
+    if(eol){
+      _queue_line(); // the event is called after the command
+      _response_line_start = true; // set
+      return false;
+    }
+  } else if(eol){
+    // check for new line (empty lines are ignored, which also handles CR+LF)
+    return (_line.available() > 0);
+  }
+
+  // classify the line while it arrives (only with the stored data)
+  if(!_line.isFull()){
+    _match_tokens(c);
+  }
+  _line.append(c);
+  return false;
+}
+
+// --------------------------------------------------
+
+// Process the event in the buffer
+//  @param (call_event) : true to call the event [bool]
+//         (tokens)     : the tokens found in the line (bit mask) [uint8_t]
+//         (recv_end)   : the position after the RECV token [uint16_t]
+//  @returns the status of the buffer [CommandResponse]
+//  NOTE: return ERROR if no data was read, DATA if there is data in the buffer or OK is an event was called
+CommandResponse SMW_SX1276M0::_process_event(bool call_event, uint8_t tokens, uint16_t recv_end){
+  // check for a valid buffer
+  if(!_buffer.available()){
+    return CommandResponse::ERROR; // not the expected result, but treat as no message
+  }
+  
+#ifdef SMW_SX1276M0_DEBUG
+  // debug
+  if(_stream_debug){
+    _buffer.print(_stream_debug);
+  }
+#endif
+
+  // check for received message
+  bool received = (tokens & (1 << SMW_SX1276M0_TOKEN_EVENT)) && (tokens & (1 << SMW_SX1276M0_TOKEN_RECV));
+  uint8_t type = 0;
+  if(received){
+    // flush the start of the message
+    for(uint16_t i=0 ; i < recv_end ; i++){
+      _buffer.read();
+    }
+
+    // get the type of the message received (string or HEX)
+    if(_buffer.available()){
+      type = _buffer.read();
+    }
+    if(type == 'B'){
+      _buffer.read(); // flush one character
+    }
+  }
+
+  // update the state
+  Event event;
+  if(!_event_state(tokens, type, event)){
+    return received ? CommandResponse::ERROR : CommandResponse::DATA; // wrong type or there is data in the buffer
+  }
+
+  if(received){
+    // the module seems to trigger the event before actually storing
+    //  the message, so a delay prevents an empty return value for a
+    //  subsequent reading (it should help when using the library)
+    _delay(10);
+  } else {
+    _buffer.reset(); // flush the buffer
+  }
+
+  // get the metadata of the payload
+  uint8_t port = 0;
+  uint16_t length = 0;
+  if(received){
+    PayloadView payload;
+    _parse_payload(_buffer, 0, port, payload);
+    length = (event == Event::RECEIVED_X) ? (payload.length / 2) : payload.length;
+  }
+
+  _event_call(event, millis(), port, length, call_event);
+
+  return received ? CommandResponse::DATA : CommandResponse::OK;
+}
+
+// --------------------------------------------------
+
+// Process the current line
+//  @param (call_event) : true to call the event [bool]
+//  @returns the status of the buffer [CommandResponse]
+//  NOTE: while a command is pending, the incoming data is part of its response
+//        and there is no line to process
+CommandResponse SMW_SX1276M0::_process_line(bool call_event){
+  if(_busy){
+    return CommandResponse::ERROR; // no unsolicited data
+  }
+
+  // move the line to the buffer
+  uint16_t length = _line.available();
+  _buffer.reset();
+  for(uint16_t i=0 ; i < length ; i++){
+    _buffer.append(_line[i]);
+  }
+  _overflow += _line.overflow() + _buffer.overflow(); // update
 
-  // send the command and read the response
-  _send_command(CMD_TXP, 1, data);
-  CommandResponse res = _read_response(SMW_SX1276M0_TIMEOUT_WRITE); // this command takes almost 1 s to reply
-  return res;
+  // get the result of the matcher and start a new line
+  uint8_t tokens = _tokens;
+  uint16_t recv_end = _token_recv_end;
+  _reset_line();
+
+  return _process_event(call_event, tokens, recv_end);
 }
 
 // --------------------------------------------------
 
-// Set the debugger of the object
-//  @param (debugger) : the stream to print to [Stream *]
-#ifdef SMW_SX1276M0_DEBUG
-void SMW_SX1276M0::setDebugger(Stream *debugger){
-  _stream_debug = debugger;
-}
-#endif
+// Parse a message in a buffer (<port>:<payload>)
+//  @param (buffer)  : the buffer with the message [Buffer (&)]
+//         (start)   : the position of the message in the buffer [uint16_t]
+//         (port)    : the application port [uint8_t (&)]
+//         (payload) : the view of the payload [PayloadView (&)]
+//  NOTE: the view is empty (null pointer) if there is no delimitter
+void SMW_SX1276M0::_parse_payload(Buffer &buffer, uint16_t start, uint8_t (&port), PayloadView (&payload)){
+  const uint8_t *data = buffer.data();
+  uint16_t length = buffer.available();
 
-// --------------------------------------------------
+  payload.data = nullptr;
+  payload.length = 0;
 
-// Set the pin for reset
-//  @param (pin_reset) : the pin to reset the module [int16_t]
-void SMW_SX1276M0::setPinReset(int16_t pin_reset){
-  _pin_reset = pin_reset;
-  pinMode(_pin_reset, OUTPUT);
-  digitalWrite(_pin_reset, LOW); // active HIGH
+  // parse the port
+  char sport[5] = { CHAR_EOS }; // 0 to 9999
+  uint8_t index = 0;
+  for(uint16_t i=start ; i < length ; i++){
+    uint8_t b = data[i];
+
+    // check for delimitter
+    if(b == CHAR_COLON){
+      payload.data = &data[i+1];
+      payload.length = length - i - 1;
+      break;
+    }
+
+    if((index < 4) && isdigit(b)){
+      sport[index++] = b;
+      sport[index] = CHAR_EOS;
+    }
+  }
+  port = atoi(sport); // convert
 }
 
 // --------------------------------------------------
 
-// Sleep
-//  @param (alarm) : the duration of the sleep [uint32_t] (default: 0)
-//  @returns the type of the response [CommandResponse]
-//  NOTE: <alarm = 0> means that the parameter is ignored
-//  NOTE: the confirmation is asynchronous (<listen()>)
-CommandResponse SMW_SX1276M0::sleep(uint32_t alarm){
-  // update the alarm if necessary
-  if(alarm){
-    CommandResponse res = set_Alarm(alarm);
-    if(res != CommandResponse::OK){
-      return res;
+// Parse an incoming byte of the response of a command
+//  @param (c) : the byte received [uint8_t]
+void SMW_SX1276M0::_parse_response(uint8_t c){
+  // check for the end of the status line (the timeout is only an upper bound)
+  if((c == 0) || (c == CHAR_LF) || (c == CHAR_CR)){
+    if((_response_status == 2) && (_response_mode == SMW_SX1276M0_RESPONSE_MODE_COMPLETION)){
+      _finish_response();
     }
+    return;
   }
 
-  _send_command(CMD_SLEEP); // send the command
+  // check the byte
+  if(c == CHAR_LT){
+    _response_status = 1;
+    return; // skip to next character
+  } else if(c == CHAR_GT){
+    _response_status = 2;
+  }
 
-  return CommandResponse::OK;
+  // store the byte if necessary
+  if(_response_status == 0){
+    if((c > 31) && (c < 127)){
+      if((_decode_state == SMW_SX1276M0_DECODE_HIGH) || (_decode_state == SMW_SX1276M0_DECODE_LOW)){
+        _decode(c); // the payload is decoded directly
+      } else {
+        _buffer.append(c);
+        if((_decode_state == SMW_SX1276M0_DECODE_PORT) && (c == CHAR_COLON)){
+          _decode_state = SMW_SX1276M0_DECODE_HIGH; // payload found
+        }
+      }
+    }
+  } else if(_response_status == 1){
+    _status.append(c);
+  } else {
+    // the remaining data is flushed
+  }
 }
 
 // --------------------------------------------------
 
-// Unset the debugger of the object
-#ifdef SMW_SX1276M0_DEBUG
-void SMW_SX1276M0::unsetDebugger(void){
-  _stream_debug = nullptr;
-}
+// Find the handler of a port
+//  @param (port) : the application port [uint8_t]
+//  @returns the index of the handler, or -1 if not found [int8_t]
+int8_t SMW_SX1276M0::_port_find(uint8_t port){
+#if SMW_SX1276M0_PORT_HANDLERS_SIZE > 0
+  if((port < 1) || (port > 223)){
+    return -1; // invalid (0 marks the empty entries)
+  }
+
+  const uint8_t mask = SMW_SX1276M0_PORT_HANDLERS_SIZE - 1;
+  uint8_t index = port & mask;
+  for(uint8_t i=0 ; i < SMW_SX1276M0_PORT_HANDLERS_SIZE ; i++){
+    if(_port_handlers[index].port == port){
+      return index;
+    } else if(_port_handlers[index].port == 0){
+      break; // end of the cluster
+    }
+    index = (index + 1) & mask;
+  }
+#else
+  (void)port;
 #endif
+  return -1;
+}
 
-// --------------------------------------------------
 // --------------------------------------------------
 
-// Custom delay in miliseconds
-//  @param (duration) : the duration of the delay in miliseconds [uint32_t]
-void SMW_SX1276M0::_delay(uint32_t duration){
-  uint32_t stop_time = millis() + duration;
-  while(millis() < stop_time){
-#if defined(ARDUINO_ESP8266_GENERIC) || defined(ARDUINO_ESP8266_NODEMCU) || defined(ARDUINO_ESP8266_THING) || defined(ARDUINO_ESP32_DEV)
-// ESP8266 Generic / NodeMCU / Sparkfun The Thing / ESP32 Dev
-    yield(); // custom function for a non blocking execution with the ESP family
+// Insert the handler of a port (not in the table)
+//  @param (port)     : the application port [uint8_t]
+//         (callback) : the function to call [DownlinkCallback]
+//         (context)  : the context for the callback [void *]
+//  @returns true if inserted (false if the table is full) [bool]
+bool SMW_SX1276M0::_port_insert(uint8_t port, DownlinkCallback callback, void *context){
+#if SMW_SX1276M0_PORT_HANDLERS_SIZE > 0
+  const uint8_t mask = SMW_SX1276M0_PORT_HANDLERS_SIZE - 1;
+  uint8_t index = port & mask;
+  for(uint8_t i=0 ; i < SMW_SX1276M0_PORT_HANDLERS_SIZE ; i++){
+    if(_port_handlers[index].port == 0){
+      _port_handlers[index].port = port;
+      _port_handlers[index].callback = callback;
+      _port_handlers[index].context = context;
+      _port_handler_count++;
+      return true;
+    }
+    index = (index + 1) & mask;
+  }
 #else
-    // do nothing
+  (void)port;
+  (void)callback;
+  (void)context;
+#endif
+  return false;
+}
+
+// --------------------------------------------------
+
+// Queue the event of the current unsolicited line (if any) and start a new line
+//  NOTE: used while the buffer holds the response of a command
+void SMW_SX1276M0::_queue_line(void){
+#ifdef SMW_SX1276M0_DEBUG
+  if(_stream_debug){
+    _line.print(_stream_debug);
+  }
 #endif
+
+  uint16_t length = _line.available();
+  uint8_t type = (_token_recv_end < length) ? _line[_token_recv_end] : 0;
+  Event event;
+  if(_event_state(_tokens, type, event)){
+    // get the metadata of the payload (<port>:<payload>)
+    uint8_t port = 0;
+    uint16_t payload_length = 0;
+    if((event == Event::RECEIVED) || (event == Event::RECEIVED_X)){
+      PayloadView payload;
+      _parse_payload(_line, _token_recv_end, port, payload);
+      payload_length = payload.length;
+      if(event == Event::RECEIVED_X){
+        payload_length /= 2; // (hexadecimal)
+      }
+    }
+    _event_push(event, port, payload_length);
   }
+  _overflow += _line.overflow(); // update
+  _reset_line();
 }
 
 // --------------------------------------------------
 
 // Read the response of a reset command
 //  @returns the type of the response [CommandResponse]
+//  NOTE: after the boot banner, the module is probed with <ping()> until it is ready
 CommandResponse SMW_SX1276M0::_read_reset(void){
-  CommandResponse res = CommandResponse::ERROR;
   CommandResponse temp;
-  uint8_t count = 0;
-  
-  // read the incoming data
-  uint32_t stop_time = millis() + SMW_SX1276M0_TIMEOUT_RESET;
-  while(millis() < stop_time){
-    temp = listen(false); // listen for incoming messages
-
-    // check for the reset event
-    if(_reset && (temp == CommandResponse::OK)){
-      _reset = false; // reset (not really necessary, but useful to prevent further errors)
-      res = CommandResponse::OK;
+  uint32_t start_time = millis();
+  uint32_t stop_time = start_time + SMW_SX1276M0_TIMEOUT_RESET;
+  _boot_time = 0; // reset
+
+  // wait for the reset event
+  while(!_reset){
+    if(millis() >= stop_time){
+      return CommandResponse::ERROR; // the module didn't reset
     }
+    listen(false); // listen for incoming messages
+  }
+  _reset = false; // reset (not really necessary, but useful to prevent further errors)
 
-    // leave the loop if there is no more data, but only after reading the reset event (or the result can be inconsistent)
-    // NOTE: <listen()> is faster than the reset procedure, so the module must be given some time before returning to the program
-    if(temp == CommandResponse::ERROR){
-      _delay(SMW_SX1276M0_DELAY_INCOMING_DATA); // give some time for data to arrive
-      count++;
-      if((count > 100) && (res == CommandResponse::OK)){
-        break;
+  // wait for the module to be ready
+  // NOTE: the module replies only after the initialization, so the first <OK> marks the end of the boot
+  while(millis() < stop_time){
+    temp = ping();
+    if(temp == CommandResponse::OK){
+      _boot_time = millis() - start_time; // update
+#ifdef SMW_SX1276M0_DEBUG
+      if(_stream_debug){
+        _stream_debug->print(F("Boot:")); // DEBUG
+        _stream_debug->println(_boot_time); // DEBUG
       }
-    } else {
-      count = 0; // reset
+#endif
+      return CommandResponse::OK;
+    }
+    
+    // give some time if the module replied something else
+    if(temp != CommandResponse::ERROR){
+      _delay(SMW_SX1276M0_DELAY_INCOMING_DATA);
     }
   }
 
-  return res;
+  return CommandResponse::ERROR;
 }
 
 // --------------------------------------------------
@@ -1562,105 +4193,161 @@ CommandResponse SMW_SX1276M0::_read_reset(void){
 //  @param (timeout) : the time to wait for the response in miliseconds [uint32_t]
 //  @returns the type of the response [CommandResponse]
 CommandResponse SMW_SX1276M0::_read_response(uint32_t timeout){
-  _buffer.reset(); // reset for storing the new response
-  
-  Buffer buffer_status(25);
-  uint8_t c;
-  uint8_t status = 0;
+  _begin_response(timeout);
 
   // read the incoming data
-  uint32_t stop_time = millis() + timeout;
-  while(millis() < stop_time){
-    if(_stream->available()){
-      c = _stream->read(); // read the incoming byte
-      
-#ifdef SMW_SX1276M0_DEBUG
-      // debug
-      if(_stream_debug){
-        if(c > 32){
-          _stream_debug->write(c);
-        } else {
-          _stream_debug->print('(');
-          _stream_debug->print(c, HEX);
-          _stream_debug->print(')');
-        }
-      }
+  while(_busy){
+    poll();
+#if defined(ARDUINO_ESP8266_GENERIC) || defined(ARDUINO_ESP8266_NODEMCU) || defined(ARDUINO_ESP8266_THING) || defined(ARDUINO_ESP32_DEV)
+// ESP8266 Generic / NodeMCU / Sparkfun The Thing / ESP32 Dev
+    yield(); // custom function for a non blocking execution with the ESP family
+#else
+    // do nothing
 #endif
+  }
 
-      // check the byte
-      if(c == CHAR_LT){
-        status = 1;
-        continue; // skip to next character
-      } else if(c == CHAR_GT){
-        status = 2;
-      }
+  return _last_response;
+}
 
-      // store the byte if necessary
-      if(status == 0){
-        if((c > 31) && (c < 127)){
-          _buffer.append(c);
-        }
-      } else if(status == 1){
-        buffer_status.append(c);
-      } else {
-        // the remaining data is flushed
+// --------------------------------------------------
+
+// Reset the current line and its matcher
+void SMW_SX1276M0::_reset_line(void){
+  _line.reset();
+  _token_state = 0;
+  _tokens = 0;
+  _token_recv_end = 0;
+}
+
+// --------------------------------------------------
+
+// Add a message to the schedule
+//  @param (command)  : the command to send (CMD_SEND or CMD_SENDB) [char *]
+//         (port)     : the application port [uint8_t]
+//         (data)     : the message [char *]
+//         (priority) : the priority of the message [uint8_t]
+//         (deadline) : the maximum time to wait [ms] [uint32_t]
+//         (callback) : the function to call with the result [CommandCallback]
+//         (context)  : the context for the callback [void *]
+//  @returns true if the message was scheduled [bool]
+//  NOTE: when full, the message replaces the one with the lowest priority
+//        and the latest deadline, if that one has a lower priority
+bool SMW_SX1276M0::_schedule_add(const char *command, uint8_t port, const char *data, uint8_t priority, uint32_t deadline, CommandCallback callback, void *context){
+  if(!data){
+    return false;
+  }
+#if SMW_SX1276M0_SCHEDULE_SIZE > 0
+  deadline += millis(); // absolute
+
+  if(_schedule_count >= SMW_SX1276M0_SCHEDULE_SIZE){
+    // find the least important message
+    uint8_t index = 0;
+    for(uint8_t i=1 ; i < _schedule_count ; i++){
+      const ScheduledUplink &entry = _schedule[i];
+      if((entry.priority < _schedule[index].priority) ||
+          ((entry.priority == _schedule[index].priority) && (static_cast<int32_t>(entry.deadline - _schedule[index].deadline) > 0))){
+        index = i;
       }
-    } else {
-#if defined(ARDUINO_ESP8266_GENERIC) || defined(ARDUINO_ESP8266_NODEMCU) || defined(ARDUINO_ESP8266_THING) || defined(ARDUINO_ESP32_DEV)
-// ESP8266 Generic / NodeMCU / Sparkfun The Thing / ESP32 Dev
-      yield(); // custom function for a non blocking execution with the ESP family
+    }
+    if(_schedule[index].priority >= priority){
+      return false;
+    }
+    _schedule_drop(index);
+  }
+
+  ScheduledUplink &entry = _schedule[_schedule_count++];
+  entry.command = command;
+  entry.port = port;
+  entry.data = data;
+  entry.priority = priority;
+  entry.deadline = deadline;
+  entry.callback = callback;
+  entry.context = context;
+
+  return true;
 #else
-      // do nothing
+  (void)command;
+  (void)port;
+  (void)priority;
+  (void)deadline;
+  (void)callback;
+  (void)context;
+  return false; // (no table)
 #endif
+}
+
+// --------------------------------------------------
+
+// Move the next scheduled message to the queue of commands
+//  NOTE: the messages are moved only when the queue is empty and the duty cycle allows,
+//        the highest priority first and then the earliest deadline (EDF)
+//  NOTE: the messages past their deadline are dropped (callback with DROPPED)
+void SMW_SX1276M0::_schedule_dispatch(void){
+#if SMW_SX1276M0_SCHEDULE_SIZE > 0
+  if(_schedule_count == 0){
+    return;
+  }
+
+  // drop the stale messages
+  uint32_t now = millis();
+  for(uint8_t i=0 ; i < _schedule_count ; ){
+    if(static_cast<int32_t>(now - _schedule[i].deadline) > 0){
+      _schedule_drop(i); // (the last entry is moved to <i>)
+    } else {
+      i++;
     }
   }
 
-  // check for a valid buffer
-  if(!buffer_status.available()){
-    return CommandResponse::ERROR; // wrong result
+  // check if a message can be sent
+  if((_schedule_count == 0) || _busy || _queue_active || (_queue_count > 0)){
+    return;
+  }
+  if(_uplink_gate && (get_UplinkWait() > 0)){
+    return;
   }
 
-  // get a copy of the buffer
-  uint8_t data_length = buffer_status.available();
-  uint8_t data[data_length];
-  buffer_status.copy(data);
-  
-#ifdef SMW_SX1276M0_DEBUG
-  // debug
-  if(_stream_debug){
-    buffer_status.print(_stream_debug);
+  // find the next message
+  uint8_t index = 0;
+  for(uint8_t i=1 ; i < _schedule_count ; i++){
+    const ScheduledUplink &entry = _schedule[i];
+    if((entry.priority > _schedule[index].priority) ||
+        ((entry.priority == _schedule[index].priority) && (static_cast<int32_t>(entry.deadline - _schedule[index].deadline) < 0))){
+      index = i;
+    }
+  }
+
+  // move to the queue
+  const ScheduledUplink &entry = _schedule[index];
+  if(_enqueue(SMW_SX1276M0_QUEUE_SEND, entry.command, nullptr, entry.port, entry.data, entry.callback, entry.context)){
+    _schedule[index] = _schedule[--_schedule_count]; // remove (the order doesn't matter)
   }
 #endif
+}
 
-  // interpret the data
-  if(status == 0){
-    return CommandResponse::ERROR; // wrong result
-  } else {
-    // check for OK
-    if(memcmp(data, RSPNS_OK, strlen(RSPNS_OK)) == 0){
-      return CommandResponse::OK;
-    }
+// --------------------------------------------------
 
-    // check for FAILED
-    void *ptr = memmem(data, data_length, RSPNS_FAILED, strlen(RSPNS_FAILED));
-    if(ptr){
-      if(data_length > strlen(RSPNS_FAILED)){
-        // at this time, doesn't store the message of the response
-        return CommandResponse::FAILED_STRING;
-      }
-      return CommandResponse::FAILED;
-    }
+// Drop a scheduled message
+//  @param (index) : the index of the message [uint8_t]
+//  NOTE: the callback is called with DROPPED and without data
+void SMW_SX1276M0::_schedule_drop(uint8_t index){
+#if SMW_SX1276M0_SCHEDULE_SIZE > 0
+  ScheduledUplink entry = _schedule[index];
+  _schedule[index] = _schedule[--_schedule_count]; // remove (the order doesn't matter)
+  _schedule_dropped++;
 
-    // check for NOT FOUND
-    ptr = memmem(data, data_length, RSPNS_NOT_FOUND, strlen(RSPNS_NOT_FOUND));
-    if(ptr){
-      if(data_length == (strlen(RSPNS_NOT_FOUND) + 12)){
-        return CommandResponse::NOT_FOUND;
-      }
-    }
+#ifdef SMW_SX1276M0_DEBUG
+  if(_stream_debug){
+    _stream_debug->println(F("Dropped")); // DEBUG
+  }
+#endif
 
-    return CommandResponse::ERROR; // wrong result
+  if(entry.callback){
+    CommandResult result = { entry.command, CommandResponse::DROPPED, 0, nullptr, entry.context }; // (no data, as another command might be pending)
+    entry.callback(result);
   }
+#else
+  (void)index;
+#endif
 }
 
 // --------------------------------------------------
@@ -1670,62 +4357,156 @@ CommandResponse SMW_SX1276M0::_read_response(uint32_t timeout){
 //         (qty)     : the quantity of other parameters to send [uint8_t]
 //         (...)     : optional and variable data to send [char *]
 void SMW_SX1276M0::_send_command(const char *command, uint8_t qty, ...){
-  flush(); // flush the data before sendig the command
-  // (it could be done in <readResponse()>, but it might flush some data in some cases - not verified)
+  _send_start(command);
+  
+  // check if there are paramenters to send
+  if(command && qty){
+    _write(CHAR_SPACE);
+    
+    va_list arg_list;
+    va_start(arg_list, qty);
+
+    for(uint8_t i=0 ; i < qty ; i++){
+      char *data = va_arg(arg_list, char *);
+      _write(reinterpret_cast<const uint8_t *>(data), strlen(data));
+    }
+    
+    va_end(arg_list);
+  }
+  
+  _send_end();
+}
+
+// --------------------------------------------------
+
+// End a command to the module
+void SMW_SX1276M0::_send_end(void){
+#ifdef SMW_SX1276M0_DEBUG
+  if(_stream_debug){
+    _stream_debug->write(CHAR_CR);
+    _stream_debug->write(']');
+  }
+#endif
+  _stream->write(CHAR_CR);
+}
+
+// --------------------------------------------------
+
+// Send a message to the module
+//  @param (command) : the command to send [char *]
+//         (port)    : the application port [uint8_t]
+//         (data)    : the data to send [char *]
+void SMW_SX1276M0::_send_payload(const char *command, uint8_t port, const char *data){
+  char sport[5]; // port stringified
+  _format_port(port, sport);
+  _send_command(command, 2, sport, data);
+
+  // store the uplink for the duty cycle
+  _uplink_length = payload_length(command, data);
+  _uplink_pending = true; // set
+}
+
+// --------------------------------------------------
+
+// Send a binary message to the module, encoding it in hexadecimal on the fly
+//  @param (command) : the command to send [char *]
+//         (port)    : the application port [uint8_t]
+//         (data)    : the data to send [uint8_t *]
+//         (length)  : the length of the data [size_t]
+//         (header)  : the data to send before <data> (optional) [uint8_t *]
+//         (header_length) : the length of the header [uint8_t]
+void SMW_SX1276M0::_send_payload(const char *command, uint8_t port, const uint8_t *data, size_t length, const uint8_t *header, uint8_t header_length){
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+  char sport[5]; // port stringified
+  _format_port(port, sport);
+
+  _send_start(command);
+  _write(CHAR_SPACE);
+  _write(reinterpret_cast<const uint8_t *>(sport), strlen(sport));
+
+  // encode in small blocks to reduce the number of writes to the stream
+  uint8_t block[32];
+  uint8_t index = 0;
+  for(size_t i=0 ; i < (header_length + length) ; i++){
+    uint8_t b = (i < header_length) ? header[i] : data[i - header_length];
+    block[index++] = HEX_DIGITS[b >> 4];
+    block[index++] = HEX_DIGITS[b & 0x0F];
+    if(index == sizeof(block)){
+      _write(block, index);
+      index = 0; // reset
+    }
+  }
+  _write(block, index);
+
+  _send_end();
+
+  // store the uplink for the duty cycle
+  _uplink_length = header_length + length;
+  _uplink_pending = true; // set
+}
+
+// --------------------------------------------------
+
+// Send the start of a command to the module (<AT+COMMAND>)
+//  @param (command) : the command to send [char *]
+void SMW_SX1276M0::_send_start(const char *command){
+  // wait for the pending command (if any)
+  while(_busy){
+    poll();
+  }
+
+  // keep the events received before the command (the other lines are discarded)
+  uint32_t timeout = millis() + SMW_SX1276M0_DELAY_INCOMING_DATA;
+  while(_stream->available() || ((_line.available() > 0) && (millis() < timeout))){
+    if(_stream->available() && _parse(_stream->read())){
+      _queue_line();
+    }
+  }
+  _reset_line(); // discard the partial line (if any)
   
 #ifdef SMW_SX1276M0_DEBUG
   if(_stream_debug){
     _stream_debug->write('[');
-    _stream_debug->write(CMD_AT);
   }
 #endif
-  _stream->write(CMD_AT); // send the <AT> prefix
+  _write(reinterpret_cast<const uint8_t *>(CMD_AT), strlen(CMD_AT)); // send the <AT> prefix
   
   // check if there is another command
   if(command){
-#ifdef SMW_SX1276M0_DEBUG
-    if(_stream_debug){
-      _stream_debug->write(CHAR_PLUS);
-      _stream_debug->write(command);
-    }
-#endif
-    _stream->write(CHAR_PLUS);
-    _stream->write(command);
+    _write(CHAR_PLUS);
+    _write(reinterpret_cast<const uint8_t *>(command), strlen(command));
+  }
+}
 
-    // check if there are paramenters to send
-    if(qty){
-#ifdef SMW_SX1276M0_DEBUG
-      if(_stream_debug){
-        _stream_debug->write(CHAR_SPACE);
-      }
-#endif
-      _stream->write(CHAR_SPACE);
-      
-      va_list arg_list;
-      va_start(arg_list, qty);
+// --------------------------------------------------
 
-      for(uint8_t i=0 ; i < qty ; i++){
-        char *data = va_arg(arg_list, char *);
-      
+// Write a byte to the module (and to the debugger)
+//  @param (c) : the byte to write [uint8_t]
+void SMW_SX1276M0::_write(uint8_t c){
 #ifdef SMW_SX1276M0_DEBUG
-        if(_stream_debug){
-          _stream_debug->write(data);
-        }
+  if(_stream_debug){
+    _stream_debug->write(c);
+  }
 #endif
-        _stream->write(data);
-      }
-      
-      va_end(arg_list);
-    }
+  _stream->write(c);
+}
+
+// --------------------------------------------------
+
+// Write data to the module (and to the debugger)
+//  @param (data)   : the data to write [uint8_t *]
+//         (length) : the length of the data [size_t]
+void SMW_SX1276M0::_write(const uint8_t *data, size_t length){
+  if(length == 0){
+    return;
   }
-  
 #ifdef SMW_SX1276M0_DEBUG
   if(_stream_debug){
-    _stream_debug->write(CHAR_CR);
-    _stream_debug->write(']');
+    _stream_debug->write(data, length);
   }
 #endif
-  _stream->write(CHAR_CR);
+  _stream->write(data, length);
 }
 
 // --------------------------------------------------
@@ -1830,3 +4611,36 @@ void * memmem(const void *haystack, size_t hlen, const void *needle, size_t nlen
 }
 
 // --------------------------------------------------
+
+// Calculate the time on air of a LoRa or FSK packet
+//  @param (sf)          : the spreading factor (7 to 12, 0 for FSK at 50 kbps) [uint8_t]
+//         (bandwidth)   : the bandwidth in kHz (125, 250 or 500) [uint16_t]
+//         (coding_rate) : the coding rate (1 to 4, for 4/5 to 4/8) [uint8_t]
+//         (length)      : the length of the PHY payload in bytes [uint16_t]
+//  @returns the time on air in microseconds [uint32_t]
+//  NOTE: uses 8 preamble symbols, explicit header and CRC (as in the LoRaWAN uplinks)
+//  NOTE: reference: Semtech AN1200.13 (LoRa Modem Designer's Guide)
+uint32_t time_on_air(uint8_t sf, uint16_t bandwidth, uint8_t coding_rate, uint16_t length){
+  // FSK: preamble (5) + sync word (3) + length (1) + payload + CRC (2) at 50 kbps
+  if(sf == 0){
+    return (5UL + 3 + 1 + length + 2) * 8 * 20; // 20 us per bit
+  }
+  if(bandwidth == 0){
+    return 0;
+  }
+
+  uint32_t symbol = (1000UL << sf) / bandwidth; // [us]
+  uint8_t low_rate = (symbol >= 16000) ? 1 : 0; // low data rate optimization (SF11 and SF12 at 125 kHz)
+
+  // payload symbols
+  int32_t numerator = (8L * length) - (4 * sf) + 28 + 16; // (with CRC and explicit header)
+  int32_t denominator = 4 * (sf - (2 * low_rate));
+  uint32_t symbols = 8;
+  if(numerator > 0){
+    symbols += ((numerator + denominator - 1) / denominator) * (coding_rate + 4);
+  }
+
+  return ((symbol * 49) / 4) + (symbols * symbol); // preamble (8 + 4.25 symbols) + payload
+}
+
+// --------------------------------------------------
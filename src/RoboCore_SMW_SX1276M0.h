@@ -32,12 +32,33 @@
 
 #define SMW_SX1276M0_DEBUG
 
-#define SMW_SX1276M0_BUFFER_SIZE              50
+#define SMW_SX1276M0_BUFFER_SIZE              50 // (0 to remove the internal buffer, see the constructors)
+#define SMW_SX1276M0_BUFFER_SIZE_LINE         50
+#define SMW_SX1276M0_BUFFER_SIZE_STATUS       25
+// NOTE: the tables below are part of the object, with the RAM given for each
+//       entry on AVR (about twice on 32-bit boards). A size of 0 removes the
+//       table (except the queue) and the functions that use it fail (or do
+//       nothing), but the queue is needed by the schedule and the confirmed
+//       messages.
+#define SMW_SX1276M0_QUEUE_SIZE                4 // [commands] (43 bytes each)
+#define SMW_SX1276M0_SCHEDULE_SIZE             4 // [messages] (14 bytes each)
+#define SMW_SX1276M0_EVENT_QUEUE_SIZE          4 // [events] (8 bytes each, without it the events received during a command are dropped)
+#define SMW_SX1276M0_SUBSCRIBERS_SIZE          4 // [subscribers] (6 bytes each)
+#define SMW_SX1276M0_PORT_HANDLERS_SIZE        8 // [ports] (power of 2, 5 bytes each)
 #define SMW_SX1276M0_DELAY_INCOMING_DATA      10 // [ms]
 #define SMW_SX1276M0_TIMEOUT_READ             25 // [ms]
 #define SMW_SX1276M0_TIMEOUT_READ_DOWNLINK   300 // [ms]
 #define SMW_SX1276M0_TIMEOUT_RESET          5000 // [ms]
 #define SMW_SX1276M0_TIMEOUT_WRITE          1000 // [ms]
+#define SMW_SX1276M0_TIMEOUT_WRITE_CONFIRMED 4000 // [ms] (after the RX windows of the acknowledgement)
+#define SMW_SX1276M0_TIMEOUT_JOIN         600000 // [ms] (all the attempts)
+#define SMW_SX1276M0_TIMEOUT_JOIN_ATTEMPT  15000 // [ms] (after the RX windows of the join accept)
+#define SMW_SX1276M0_JOIN_BACKOFF_MIN      10000 // [ms]
+#define SMW_SX1276M0_JOIN_BACKOFF_MAX     300000 // [ms]
+#define SMW_SX1276M0_CONFIRMED_SIZE            4 // [messages] (25 bytes each, see the tables above)
+#define SMW_SX1276M0_CONFIRMED_RETRIES         3
+#define SMW_SX1276M0_CONFIRMED_BACKOFF_MIN  5000 // [ms]
+#define SMW_SX1276M0_CONFIRMED_BACKOFF_MAX 120000 // [ms]
 
 
 // --------------------------------------------------
@@ -52,6 +73,8 @@ extern "C" {
 }
 
 #include "Buffer.h"
+#include "Fragment.h"
+#include "UplinkLog.h"
 
 
 // --------------------------------------------------
@@ -106,12 +129,20 @@ const char* const CMD_P2P_WORD = "P2PSW"; // P2P Sync Word (11.2.3)
 const char* const RSPNS_OK = "OK";
 const char* const RSPNS_FAILED = "Failed";
 const char* const RSPNS_NOT_FOUND = "Found";
-const uint8_t RSPNS_BOOT[] = { 0x07 , '*' };
+constexpr uint8_t RSPNS_BOOT[] = { 0x07 , '*' };
 
-const char* const RSPNS_EVENT = "[EVENT]";
-const char* const RSPNS_JOINED = "JOINED";
-const char* const RSPNS_RECV = "RECV";
-const char* const RSPNS_SLEEP = "SLEEP";
+constexpr const char* RSPNS_EVENT = "[EVENT]";
+constexpr const char* RSPNS_JOINED = "JOINED";
+constexpr const char* RSPNS_RECV = "RECV";
+constexpr const char* RSPNS_SLEEP = "SLEEP";
+
+// tokens of the unsolicited lines (index in the matcher)
+#define SMW_SX1276M0_TOKEN_EVENT   0
+#define SMW_SX1276M0_TOKEN_SLEEP   1
+#define SMW_SX1276M0_TOKEN_JOINED  2
+#define SMW_SX1276M0_TOKEN_RECV    3
+#define SMW_SX1276M0_TOKEN_BOOT    4
+#define SMW_SX1276M0_TOKEN_COUNT   5
 
 
 // --------------------------------------------------
@@ -133,8 +164,153 @@ const char* const RSPNS_SLEEP = "SLEEP";
 #define SMW_SX1276M0_JOIN_STATUS_NOT_JOINED 0
 #define SMW_SX1276M0_JOIN_STATUS_JOINED     1
 
-enum class CommandResponse : uint8_t { ERROR , OK , FAILED , FAILED_STRING , NOT_FOUND , DATA };
-enum class Event : uint8_t { JOINED , RECEIVED , RECEIVED_X , SLEEP , WAKEUP , RESET };
+// parameters in the shadow of the configuration (index)
+#define SMW_SX1276M0_SHADOW_ADR            0
+#define SMW_SX1276M0_SHADOW_AJOIN          1
+#define SMW_SX1276M0_SHADOW_APPEUI         2
+#define SMW_SX1276M0_SHADOW_APPKEY         3
+#define SMW_SX1276M0_SHADOW_APPSKEY        4
+#define SMW_SX1276M0_SHADOW_CONFIRMATION   5
+#define SMW_SX1276M0_SHADOW_DEVADDR        6
+#define SMW_SX1276M0_SHADOW_DEVEUI         7
+#define SMW_SX1276M0_SHADOW_DR             8
+#define SMW_SX1276M0_SHADOW_ECHO           9
+#define SMW_SX1276M0_SHADOW_JOIN_MODE     10
+#define SMW_SX1276M0_SHADOW_NWKSKEY       11
+#define SMW_SX1276M0_SHADOW_P2P_DEVADDR   12
+#define SMW_SX1276M0_SHADOW_P2P_WORD      13
+#define SMW_SX1276M0_SHADOW_REGION        14
+#define SMW_SX1276M0_SHADOW_RETRIES       15
+#define SMW_SX1276M0_SHADOW_TXP           16
+#define SMW_SX1276M0_SHADOW_COUNT         17
+
+#define SMW_SX1276M0_SHADOW_KEYS_SIZE     72 // [bytes] (the keys are stored in binary)
+
+// result of each parameter in <apply()>
+#define SMW_SX1276M0_APPLY_SKIPPED     0 // not in the configuration
+#define SMW_SX1276M0_APPLY_UNCHANGED   1 // the module already had the value
+#define SMW_SX1276M0_APPLY_SET         2
+#define SMW_SX1276M0_APPLY_FAILED      3
+
+#define SMW_SX1276M0_CONFIG_UNSET     -1 // the numeric parameter is not applied
+
+// regions (as in <set_Region()>)
+#define SMW_SX1276M0_REGION_AS923  0
+#define SMW_SX1276M0_REGION_AU915  1
+#define SMW_SX1276M0_REGION_CN470  2
+#define SMW_SX1276M0_REGION_CN779  3
+#define SMW_SX1276M0_REGION_EU433  4
+#define SMW_SX1276M0_REGION_EU868  5
+#define SMW_SX1276M0_REGION_KR920  6
+#define SMW_SX1276M0_REGION_IN865  7
+#define SMW_SX1276M0_REGION_US915  8
+#define SMW_SX1276M0_REGION_RU864  9
+#define SMW_SX1276M0_REGION_COUNT 10
+
+#define SMW_SX1276M0_RESPONSE_MODE_TIMEOUT    0 // wait for the full timeout
+#define SMW_SX1276M0_RESPONSE_MODE_COMPLETION 1 // return on the end of the status line
+
+enum class CommandResponse : uint8_t { ERROR , OK , FAILED , FAILED_STRING , NOT_FOUND , DATA , DUTY_CYCLE , TOO_LONG , DROPPED };
+enum class Event : uint8_t { JOINED , RECEIVED , RECEIVED_X , SLEEP , WAKEUP , RESET , ACKNOWLEDGED , NOT_ACKNOWLEDGED };
+enum class JoinState : uint8_t { IDLE , JOINING , JOINED , FAILED };
+enum class ConfirmedState : uint8_t { PENDING , ACKED , FAILED };
+
+// Masks of the events for <subscribe()>
+#define SMW_SX1276M0_EVENT_MASK(event)  (1U << static_cast<uint8_t>(event))
+#define SMW_SX1276M0_EVENT_ALL          0xFFFF
+
+// Data of an event (see <subscribe()>)
+struct EventInfo {
+  Event event;
+  uint32_t time; // [ms] the time the event was received (<millis()>)
+  uint8_t port; // the application port (RECEIVED, RECEIVED_X, ACKNOWLEDGED and NOT_ACKNOWLEDGED)
+  uint16_t length; // the length of the payload in bytes (idem, if given by the module)
+  void *context; // the context given to <subscribe()>
+};
+
+typedef void (*EventCallback)(EventInfo (&));
+
+// Report of a confirmed message (see <confirm_sendT()>)
+struct ConfirmedReport {
+  const char *data; // the message (as given)
+  uint8_t port;
+  ConfirmedState state;
+  uint8_t attempts; // the number of sends
+  uint32_t latency; // [ms] from the first send to the acknowledgement (or to the failure)
+};
+
+// View of a payload stored in the driver (no copy)
+//  NOTE: valid until the next command or <listen()>/<poll()>
+struct PayloadView {
+  const uint8_t *data;
+  uint16_t length;
+};
+
+// Downlink given to the handlers of the ports (see <setPortHandler()>)
+struct Downlink {
+  uint8_t port;
+  PayloadView payload; // the text or the decoded bytes (valid only during the callback)
+  bool hex; // true if received as hexadecimal (RECEIVED_X)
+  void *context; // the context given to <setPortHandler()>
+};
+
+typedef void (*DownlinkCallback)(Downlink (&));
+
+// Priorities of the scheduled messages (any value can be used, the highest first)
+#define SMW_SX1276M0_PRIORITY_LOW     0
+#define SMW_SX1276M0_PRIORITY_NORMAL  1
+#define SMW_SX1276M0_PRIORITY_HIGH    2
+
+// Result of a queued command
+struct CommandResult {
+  const char *command; // the command sent (CMD_*)
+  CommandResponse response;
+  int32_t value; // the numeric value of the data (only for queries)
+  Buffer *data; // the data of the response (valid only during the callback, nullptr if DROPPED)
+  void *context; // the context given to the queue
+};
+
+typedef void (*CommandCallback)(CommandResult (&));
+
+// Configuration profile of the module (for <apply()>)
+//  NOTE: only the parameters that are set are applied (not null or not SMW_SX1276M0_CONFIG_UNSET)
+//  NOTE: an aggregate, so it can be initialized with braces (even in C++11). The
+//        members missing from the braces are zero (a valid value), so start
+//        from <SMW_SX1276M0_CONFIG_EMPTY> to set only some parameters.
+struct SMW_SX1276M0_Config {
+  int16_t join_mode;
+  int16_t region;
+  const char *deveui;
+  const char *appeui;
+  const char *appkey;
+  const char *devaddr;
+  const char *nwkskey;
+  const char *appskey;
+  int16_t adr;
+  int16_t dr;
+  int16_t tx_power;
+  int16_t confirmation;
+  int16_t retries;
+  int16_t echo;
+  const char *p2p_devaddr;
+  int16_t p2p_sync_word;
+  int16_t ajoin;
+};
+
+// profile without parameters (nothing is applied)
+constexpr SMW_SX1276M0_Config SMW_SX1276M0_CONFIG_EMPTY = {
+  SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET , // join mode, region
+  nullptr , nullptr , nullptr , nullptr , nullptr , nullptr , // DevEUI, AppEUI, AppKey, DevAddr, NwkSKey, AppSKey
+  SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET , // ADR, DR, TX power
+  SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET , SMW_SX1276M0_CONFIG_UNSET , // confirmation, retries, echo
+  nullptr , SMW_SX1276M0_CONFIG_UNSET , // P2P address and sync word
+  SMW_SX1276M0_CONFIG_UNSET // automatic join
+};
+
+// Result of <apply()> for each parameter
+struct SMW_SX1276M0_ConfigReport {
+  uint8_t status[SMW_SX1276M0_SHADOW_COUNT]; // the result of each parameter (SMW_SX1276M0_APPLY_*), indexed by SMW_SX1276M0_SHADOW_*
+};
 
 
 // --------------------------------------------------
@@ -147,6 +323,7 @@ enum class Event : uint8_t { JOINED , RECEIVED , RECEIVED_X , SLEEP , WAKEUP , R
 #define SMW_SX1276M0_SIZE_DEVADDR    8
 #define SMW_SX1276M0_SIZE_NWKSKEY   32
 #define SMW_SX1276M0_SIZE_VERSION   10
+#define SMW_SX1276M0_SIZE_PARAMETER 32 // the largest parameter (keys)
 
 
 // --------------------------------------------------
@@ -155,49 +332,92 @@ enum class Event : uint8_t { JOINED , RECEIVED , RECEIVED_X , SLEEP , WAKEUP , R
 class SMW_SX1276M0 {
   public:
     void (*event_listener)(Event);
+    void (*response_listener)(CommandResponse);
     
+#if SMW_SX1276M0_BUFFER_SIZE > 0
     SMW_SX1276M0(Stream (&));
     SMW_SX1276M0(Stream (&), int16_t);
+#endif
+    SMW_SX1276M0(Stream (&), int16_t, Buffer (&));
+    CommandResponse apply(const SMW_SX1276M0_Config (&), SMW_SX1276M0_ConfigReport (&));
+    bool enqueue_get(const char *, CommandCallback = nullptr, void * = nullptr);
+    bool enqueue_sendT(uint8_t, const char *, CommandCallback = nullptr, void * = nullptr);
+    bool enqueue_sendX(uint8_t, const char *, CommandCallback = nullptr, void * = nullptr);
+    bool enqueue_set(const char *, const char *, CommandCallback = nullptr, void * = nullptr);
+    bool confirm_sendT(uint8_t, const char *, uint8_t = SMW_SX1276M0_CONFIRMED_RETRIES);
+    bool confirm_sendX(uint8_t, const char *, uint8_t = SMW_SX1276M0_CONFIRMED_RETRIES);
     void flush(void);
+    CommandResponse forward(UplinkLog (&));
     CommandResponse get_ADR(uint8_t (&));
     CommandResponse get_AJoin(uint8_t (&));
     CommandResponse get_Alarm(uint32_t (&));
     CommandResponse get_AppEUI(char (&)[SMW_SX1276M0_SIZE_APPEUI]);
     CommandResponse get_AppKey(char (&)[SMW_SX1276M0_SIZE_APPKEY]);
     CommandResponse get_AppSKey(char (&)[SMW_SX1276M0_SIZE_APPSKEY]);
+    uint32_t get_BootTime(void);
+    uint32_t get_EventsDropped(void);
+    uint32_t get_EventTime(void);
     CommandResponse get_Confirmation(uint8_t (&));
+    uint32_t get_ConfirmedCount(ConfirmedState);
+    void get_ConfirmedReport(ConfirmedReport (&));
     CommandResponse get_DevAddr(char (&)[SMW_SX1276M0_SIZE_DEVADDR]);
     CommandResponse get_DevEUI(char (&)[SMW_SX1276M0_SIZE_DEVEUI]);
     CommandResponse get_DR(uint8_t (&));
     CommandResponse get_Echo(uint8_t (&));
     void get_buffer(Buffer (&));
+    uint8_t get_JoinAttempts(void);
     CommandResponse get_JoinMode(uint8_t (&));
+    JoinState get_JoinState(void);
     CommandResponse get_JoinStatus(uint8_t (&));
+    CommandResponse get_LastResponse(void);
     CommandResponse get_NumberOfRetries(uint8_t (&));
     CommandResponse get_NwkSKey(char (&)[SMW_SX1276M0_SIZE_NWKSKEY]);
+    uint32_t get_Overflow(void);
     CommandResponse get_P2P_DevAddr(char (&)[SMW_SX1276M0_SIZE_DEVADDR]);
     CommandResponse get_P2P_SyncWord(uint8_t (&));
+    uint8_t get_QueueCount(void);
     CommandResponse get_Region(uint8_t (&));
+    uint32_t get_ResponseTime(void);
     CommandResponse get_RSSI(double (&));
+    uint8_t get_ScheduleCount(void);
+    uint32_t get_ScheduleDropped(void);
     CommandResponse get_SNR(double (&));
     CommandResponse get_TXPower(uint8_t (&));
+    uint32_t get_TimeOnAir(uint16_t);
+    uint32_t get_UplinkWait(void);
     CommandResponse get_Version(char (&)[SMW_SX1276M0_SIZE_VERSION]);
+    void invalidateShadow(void);
+    bool isBusy(void);
     bool isConnected(void);
     bool isSleeping(void);
     void join(void);
+    bool join_async(uint32_t = SMW_SX1276M0_TIMEOUT_JOIN);
     CommandResponse listen(bool = true);
+    uint16_t listen_all(bool = true);
+    CommandResponse log_sendX(UplinkLog (&), uint8_t, const uint8_t *, size_t);
+    uint8_t max_payload(void);
     CommandResponse ping(void);
+    void poll(void);
     CommandResponse readT(void);
     CommandResponse readT(Buffer (&));
     CommandResponse readT(uint8_t (&), Buffer (&));
+    CommandResponse readT(uint8_t (&), PayloadView (&));
     CommandResponse readX(void);
     CommandResponse readX(Buffer (&));
     CommandResponse readX(uint8_t (&), Buffer (&));
+    CommandResponse readX(uint8_t (&), PayloadView (&));
+    CommandResponse readX(uint8_t (&), uint8_t *, uint16_t, uint16_t (&));
     CommandResponse reset(void);
+    bool schedule_sendT(uint8_t, const char *, uint8_t, uint32_t, CommandCallback = nullptr, void * = nullptr);
+    bool schedule_sendX(uint8_t, const char *, uint8_t, uint32_t, CommandCallback = nullptr, void * = nullptr);
     CommandResponse sendT(uint8_t, const char *);
     CommandResponse sendT(uint8_t, const String);
+    CommandResponse sendT_async(uint8_t, const char *);
     CommandResponse sendX(uint8_t, const char *);
     CommandResponse sendX(uint8_t, const String);
+    CommandResponse sendFragmented(uint8_t, const uint8_t *, size_t);
+    CommandResponse sendX(uint8_t, const uint8_t *, size_t);
+    CommandResponse sendX_async(uint8_t, const char *);
     CommandResponse set_ADR(uint8_t);
     CommandResponse set_AJoin(uint8_t);
     CommandResponse set_Alarm(uint32_t);
@@ -219,28 +439,206 @@ class SMW_SX1276M0 {
 #ifdef SMW_SX1276M0_DEBUG
     void setDebugger(Stream *);
 #endif
+    void setDefaultHandler(DownlinkCallback, void * = nullptr);
+    void setDutyCycle(bool);
     void setPinReset(int16_t);
+    bool setPortHandler(uint8_t, DownlinkCallback, void * = nullptr);
+    void setResponseMode(uint8_t);
     CommandResponse sleep(uint32_t = 0);
+    bool subscribe(EventCallback, void * = nullptr, uint16_t = SMW_SX1276M0_EVENT_ALL);
 #ifdef SMW_SX1276M0_DEBUG
     void unsetDebugger(void);
 #endif
+    bool unsubscribe(EventCallback, void * = nullptr);
 
   private:
+    struct QueuedCommand {
+      uint8_t type;
+      const char *command;
+      char parameter[SMW_SX1276M0_SIZE_PARAMETER + 1];
+      uint8_t port;
+      const char *data;
+      CommandCallback callback;
+      void *context;
+    };
+
+    struct QueuedEvent {
+      Event event;
+      uint32_t time; // [ms] (millis())
+      uint8_t port;
+      uint16_t length;
+    };
+
+    struct PortHandler {
+      uint8_t port; // (0 if empty)
+      DownlinkCallback callback;
+      void *context;
+    };
+
+    struct Subscriber {
+      EventCallback callback;
+      void *context;
+      uint16_t mask;
+    };
+
+    struct ConfirmedUplink {
+      ConfirmedReport report;
+      const char *command;
+      uint8_t retries; // the maximum number of retries
+      bool queued; // true if in the queue of commands
+      uint32_t first; // the time of the first send
+      uint32_t time; // the time of the last send
+      uint32_t backoff; // the time to wait before the next send
+    };
+
+    struct ScheduledUplink {
+      const char *command;
+      uint8_t port;
+      const char *data;
+      uint8_t priority;
+      uint32_t deadline; // [ms] (absolute)
+      CommandCallback callback;
+      void *context;
+    };
+
     Stream* _stream;
     int16_t _pin_reset;
-    Buffer _buffer;
+#if SMW_SX1276M0_BUFFER_SIZE > 0
+    StaticBuffer<SMW_SX1276M0_BUFFER_SIZE> _buffer_internal; // (used only without an external buffer)
+#endif
+    Buffer &_buffer;
+    StaticBuffer<SMW_SX1276M0_BUFFER_SIZE_LINE> _line;
+    StaticBuffer<SMW_SX1276M0_BUFFER_SIZE_STATUS> _status;
+    bool _busy;
+    bool _busy_async;
+    uint32_t _command_start;
+    uint32_t _command_timeout;
+    CommandResponse _last_response;
+    uint8_t _response_status;
+    QueuedCommand _queue[SMW_SX1276M0_QUEUE_SIZE];
+    uint8_t _queue_head;
+    uint8_t _queue_count;
+    bool _queue_active;
+#if SMW_SX1276M0_SCHEDULE_SIZE > 0
+    ScheduledUplink _schedule[SMW_SX1276M0_SCHEDULE_SIZE];
+#endif
+    uint8_t _schedule_count;
+    uint32_t _schedule_dropped;
+    uint32_t _overflow;
+#if SMW_SX1276M0_EVENT_QUEUE_SIZE > 0
+    QueuedEvent _events[SMW_SX1276M0_EVENT_QUEUE_SIZE];
+#endif
+    uint8_t _event_head;
+    uint8_t _event_count;
+    uint32_t _events_dropped;
+    uint32_t _event_time; // the time of the current event
+    bool _response_line_start; // true at the start of a line of the response
+#if SMW_SX1276M0_SUBSCRIBERS_SIZE > 0
+    Subscriber _subscribers[SMW_SX1276M0_SUBSCRIBERS_SIZE];
+#endif
+    uint8_t _subscriber_count;
+    uint8_t _subscriber_calls; // the number of nested calls of the subscribers (the removals are deferred)
+#if SMW_SX1276M0_PORT_HANDLERS_SIZE > 0
+    PortHandler _port_handlers[SMW_SX1276M0_PORT_HANDLERS_SIZE]; // (hash table, by port)
+#endif
+    uint8_t _port_handler_count;
+    DownlinkCallback _default_handler;
+    void *_default_context;
+    uint8_t *_decode_data;
+    uint16_t _decode_size;
+    uint16_t _decode_length;
+    uint8_t _decode_state;
+    uint8_t _decode_high;
+    uint8_t _token_state; // the state of the matcher
+    uint8_t _tokens; // the tokens found in the current line (bit mask)
+    uint16_t _token_recv_end; // the position after the RECV token
+    uint32_t _shadow[SMW_SX1276M0_SHADOW_COUNT]; // the values set or read (except the keys)
+    uint8_t _shadow_keys[SMW_SX1276M0_SHADOW_KEYS_SIZE]; // the keys set or read (in binary)
+    uint32_t _shadow_valid; // the valid values in the shadow (bit mask)
     bool _connected;
     bool _reset;
     bool _sleeping;
+    uint8_t _response_mode;
+    uint32_t _response_time;
+    uint32_t _boot_time;
+    JoinState _join_state;
+    uint8_t _join_step;
+    uint8_t _join_attempts;
+    uint32_t _join_start;
+    uint32_t _join_deadline;
+    uint32_t _join_time; // the start of the current step
+    uint32_t _join_backoff;
+    bool _uplink_gate;
+    bool _uplink_pending; // true if the pending command is an uplink
+    uint16_t _uplink_length; // the length of the pending uplink
+    uint32_t _uplink_start;
+    uint32_t _uplink_off; // the off time of the duty cycle
+    uint8_t _uplink_dr; // the data rate of the last uplink (kept with the ADR until read again)
+#if SMW_SX1276M0_CONFIRMED_SIZE > 0
+    ConfirmedUplink _confirmed[SMW_SX1276M0_CONFIRMED_SIZE];
+#endif
+    uint8_t _confirmed_count;
+    ConfirmedReport _confirmed_last; // the last message completed
+    uint32_t _confirmed_acked;
+    uint32_t _confirmed_failed;
+    uint8_t _fragment_id; // the ID of the next fragmented message
     
 #ifdef SMW_SX1276M0_DEBUG
     Stream* _stream_debug;
 #endif
 
+    void _apply_read(uint8_t);
+    bool _apply_value(const SMW_SX1276M0_Config (&), uint8_t, uint32_t (&), char (&)[SMW_SX1276M0_SIZE_PARAMETER + 1]);
+    CommandResponse _apply_write(const SMW_SX1276M0_Config (&), uint8_t);
+    void _begin_response(uint32_t, bool = false);
+    void _decode(uint8_t);
+    bool _confirmed_add(const char *, uint8_t, const char *, uint8_t);
+    void _confirmed_process(void);
+    static void _confirmed_result(CommandResult (&));
     void _delay(uint32_t);
+    void _downlink_dispatch(Event, uint8_t);
+    void _event_call(Event, uint32_t, uint8_t, uint16_t, bool = true);
+    uint8_t _event_deliver(bool);
+    void _event_push(Event, uint8_t, uint16_t);
+    bool _event_state(uint8_t, uint8_t, Event (&));
+    bool _enqueue(uint8_t, const char *, const char *, uint8_t, const char *, CommandCallback, void *);
+    void _join_backoff_next(void);
+    void _join_process(void);
+    static void _join_result(CommandResult (&));
+    void _finish_queued(CommandResponse);
+    void _finish_response(void);
+    void _format_port(uint8_t, char (&)[5]);
+    void _match_tokens(uint8_t);
+    void _issue_queued(void);
+    bool _parse(uint8_t);
+    void _parse_payload(Buffer (&), uint16_t, uint8_t (&), PayloadView (&));
+    void _parse_response(uint8_t);
+    int8_t _port_find(uint8_t);
+    bool _port_insert(uint8_t, DownlinkCallback, void *);
+    void _queue_line(void);
+    void _reset_line(void);
+    bool _schedule_add(const char *, uint8_t, const char *, uint8_t, uint32_t, CommandCallback, void *);
+    void _schedule_dispatch(void);
+    void _schedule_drop(uint8_t);
+    bool _shadow_check(uint8_t, uint32_t);
+    bool _shadow_check(uint8_t, const char *);
+    void _shadow_update(uint8_t, uint32_t, CommandResponse);
+    void _shadow_update(uint8_t, const char *, CommandResponse);
+    CommandResponse _process_event(bool, uint8_t, uint16_t);
+    CommandResponse _process_line(bool);
     CommandResponse _read_reset(void);
     CommandResponse _read_response(uint32_t);
     void _send_command(const char *, uint8_t = 0, ...);
+    void _send_end(void);
+    void _send_payload(const char *, uint8_t, const char *);
+    void _send_payload(const char *, uint8_t, const uint8_t *, size_t, const uint8_t * = nullptr, uint8_t = 0);
+    void _send_start(const char *);
+    CommandResponse _uplink_check(uint16_t, bool);
+    bool _uplink_datarate(uint8_t (&), uint16_t (&));
+    void _uplink_register(uint16_t);
+    bool _uplink_settings(uint8_t (&), uint8_t (&));
+    void _write(uint8_t);
+    void _write(const uint8_t *, size_t);
 };
 
 // --------------------------------------------------
@@ -260,4 +658,27 @@ void * memmem(const void *, size_t, const void *, size_t);
 
 // --------------------------------------------------
 
+uint32_t time_on_air(uint8_t, uint16_t, uint8_t, uint16_t);
+
+// --------------------------------------------------
+
+// Get the maximum application payload of a region and data rate (without FOpts)
+//  @param (region) : the region (SMW_SX1276M0_REGION_*) [uint8_t]
+//         (dr)     : the data rate (0 to 7) [uint8_t]
+//  @returns the maximum length in bytes (0 if the data rate is not defined) [uint8_t]
+//  NOTE: constexpr, so it can size the buffers at compile time
+//  NOTE: as in the LoRaWAN Regional Parameters (AS923 and AU915 without the dwell time limit)
+//  NOTE: CN470 and KR920 have only DR0 to DR5, IN865 has no DR6 and the
+//        other regions use FSK in DR7 (222 bytes)
+constexpr uint8_t max_payload(uint8_t region, uint8_t dr){
+  return ((region >= SMW_SX1276M0_REGION_COUNT) || (dr > 7)) ? 0 :
+    (region == SMW_SX1276M0_REGION_US915) ? ((dr == 0) ? 11 : (dr == 1) ? 53 : (dr == 2) ? 125 : (dr <= 4) ? 242 : 0) :
+    (region == SMW_SX1276M0_REGION_AU915) ? ((dr <= 2) ? 51 : (dr == 3) ? 115 : (dr <= 6) ? 242 : 0) :
+    (((region == SMW_SX1276M0_REGION_CN470) || (region == SMW_SX1276M0_REGION_KR920)) && (dr > 5)) ? 0 :
+    ((region == SMW_SX1276M0_REGION_IN865) && (dr == 6)) ? 0 :
+    ((dr <= 2) ? 51 : (dr == 3) ? 115 : (dr == 7) ? 222 : 242);
+}
+
+// --------------------------------------------------
+
 #endif // SMW_SX1276M0_H
@@ -0,0 +1,307 @@
+/*******************************************************************************
+* RoboCore Uplink Log Library (v1.0)
+* 
+* Library to store the uplinks in a persistent ring (store-and-forward).
+* 
+* Copyright 2022 RoboCore.
+* 
+* 
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+* 
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+#include "UplinkLog.h"
+
+// --------------------------------------------------
+// Dependencies
+
+extern "C" {
+  #include <string.h>
+}
+
+// --------------------------------------------------
+// Constants
+
+// The state of a record (0xFF is the erased memory)
+#define UPLINK_LOG_STATE_FREE     0xFF
+#define UPLINK_LOG_STATE_PENDING  0x55
+#define UPLINK_LOG_STATE_SENT     0x00
+
+#define UPLINK_LOG_OFFSET_SEQUENCE  0
+#define UPLINK_LOG_OFFSET_STATE     2
+#define UPLINK_LOG_OFFSET_PORT      3
+#define UPLINK_LOG_OFFSET_LENGTH    4
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Constructor
+//  @param (storage)   : the persistent memory [LogStorage (&)]
+//         (data_size) : the maximum length of the data of a record [uint8_t] (default: UPLINK_LOG_DATA_SIZE)
+//  NOTE: the storage must outlive the object
+//  NOTE: the data size is limited to UPLINK_LOG_DATA_SIZE (the buffer of <SMW_SX1276M0::forward()>)
+//  NOTE: call <begin()> before using the log
+UplinkLog::UplinkLog(LogStorage &storage, uint8_t data_size) :
+  _storage(storage),
+  _data_size((data_size < UPLINK_LOG_DATA_SIZE) ? data_size : UPLINK_LOG_DATA_SIZE),
+  _capacity(0),
+  _head(0),
+  _tail(0),
+  _available(0),
+  _sequence(0),
+  _dropped(0),
+  _rejected(0)
+  {
+  // nothing to do here
+}
+
+// --------------------------------------------------
+
+// Append a record to the log
+//  @param (port)   : the application port [uint8_t]
+//         (data)   : the data to store [uint8_t *]
+//         (length) : the length of the data [uint8_t]
+//  @returns true if the record was stored [bool]
+//  NOTE: the oldest record is overwritten if the log is full
+bool UplinkLog::append(uint8_t port, const uint8_t *data, uint8_t length){
+  if((_capacity == 0) || (length > _data_size) || ((length > 0) && !data)){
+    return false;
+  }
+
+  // drop the oldest record (if full)
+  if(_available == _capacity){
+    _tail = (_tail + 1) % _capacity;
+    _available--;
+    _dropped++;
+  }
+
+  // invalidate the record before writing, so that a partial write is discarded
+  if(!_write_state(_head, UPLINK_LOG_STATE_FREE)){
+    return false;
+  }
+
+  uint8_t header[UPLINK_LOG_HEADER_SIZE];
+  header[UPLINK_LOG_OFFSET_SEQUENCE] = _sequence & 0xFF;
+  header[UPLINK_LOG_OFFSET_SEQUENCE + 1] = _sequence >> 8;
+  header[UPLINK_LOG_OFFSET_STATE] = UPLINK_LOG_STATE_FREE;
+  header[UPLINK_LOG_OFFSET_PORT] = port;
+  header[UPLINK_LOG_OFFSET_LENGTH] = length;
+  uint32_t address = _address(_head);
+  if(!_storage.write(address, header, UPLINK_LOG_HEADER_SIZE) ||
+      ((length > 0) && !_storage.write(address + UPLINK_LOG_HEADER_SIZE, data, length))){
+    return false;
+  }
+
+  // commit
+  if(!_write_state(_head, UPLINK_LOG_STATE_PENDING)){
+    return false;
+  }
+
+  if(_available == 0){
+    _tail = _head;
+  }
+  _head = (_head + 1) % _capacity;
+  _available++;
+  _sequence++;
+
+  return true;
+}
+
+// --------------------------------------------------
+
+// Get the number of records pending
+//  @returns the number of records [uint16_t]
+uint16_t UplinkLog::available(void){
+  return _available;
+}
+
+// --------------------------------------------------
+
+// Find the records in the storage
+//  @returns true if the storage can hold at least one record [bool]
+//  NOTE: reads the header of every record (once)
+bool UplinkLog::begin(void){
+  _capacity = _storage.size() / (UPLINK_LOG_HEADER_SIZE + _data_size);
+  _head = 0;
+  _tail = 0;
+  _available = 0;
+  _sequence = 0;
+  if(_capacity == 0){
+    return false;
+  }
+
+  // find the newest record
+  bool found = false;
+  uint16_t newest = 0;
+  uint8_t header[UPLINK_LOG_HEADER_SIZE];
+  for(uint16_t i=0 ; i < _capacity ; i++){
+    if(!_storage.read(_address(i), header, UPLINK_LOG_HEADER_SIZE)){
+      return false;
+    }
+    uint8_t state = header[UPLINK_LOG_OFFSET_STATE];
+    if((state != UPLINK_LOG_STATE_PENDING) && (state != UPLINK_LOG_STATE_SENT)){
+      continue;
+    }
+    uint16_t sequence = header[UPLINK_LOG_OFFSET_SEQUENCE] | (header[UPLINK_LOG_OFFSET_SEQUENCE + 1] << 8);
+    if(!found || (static_cast<int16_t>(sequence - _sequence) >= 0)){
+      found = true;
+      newest = i;
+      _sequence = sequence;
+    }
+  }
+  if(!found){
+    return true; // empty
+  }
+  _head = (newest + 1) % _capacity;
+  _sequence++;
+
+  // find the oldest pending record (they are contiguous, up to the newest)
+  uint16_t index = newest;
+  uint16_t sequence = _sequence - 1;
+  while(_available < _capacity){
+    if(!_storage.read(_address(index), header, UPLINK_LOG_HEADER_SIZE)){
+      return false;
+    }
+    if((header[UPLINK_LOG_OFFSET_STATE] != UPLINK_LOG_STATE_PENDING) ||
+        ((header[UPLINK_LOG_OFFSET_SEQUENCE] | (header[UPLINK_LOG_OFFSET_SEQUENCE + 1] << 8)) != sequence)){
+      break;
+    }
+    _tail = index;
+    _available++;
+    index = (index == 0) ? (_capacity - 1) : (index - 1);
+    sequence--;
+  }
+
+  return true;
+}
+
+// --------------------------------------------------
+
+// Get the capacity of the log
+//  @returns the maximum number of records [uint16_t]
+uint16_t UplinkLog::capacity(void){
+  return _capacity;
+}
+
+// --------------------------------------------------
+
+// Discard all the records pending
+void UplinkLog::clear(void){
+  while(_available > 0){
+    pop();
+  }
+}
+
+// --------------------------------------------------
+
+// Get the maximum length of the data of a record
+//  @returns the length in bytes [uint8_t]
+uint8_t UplinkLog::data_size(void){
+  return _data_size;
+}
+
+// --------------------------------------------------
+
+// Get the number of records overwritten before being sent
+//  @returns the number of records [uint32_t]
+//  NOTE: not persistent
+uint32_t UplinkLog::dropped(void){
+  return _dropped;
+}
+
+// --------------------------------------------------
+
+// Read the oldest record pending
+//  @param (port)   : the variable to store the application port [uint8_t (&)]
+//         (data)   : the array to store the data (at least the data size of the log) [uint8_t *]
+//         (length) : the variable to store the length of the data [uint8_t (&)]
+//  @returns true if a record was read [bool]
+bool UplinkLog::peek(uint8_t &port, uint8_t *data, uint8_t &length){
+  if((_available == 0) || !data){
+    return false;
+  }
+
+  uint8_t header[UPLINK_LOG_HEADER_SIZE];
+  uint32_t address = _address(_tail);
+  if(!_storage.read(address, header, UPLINK_LOG_HEADER_SIZE)){
+    return false;
+  }
+  port = header[UPLINK_LOG_OFFSET_PORT];
+  length = header[UPLINK_LOG_OFFSET_LENGTH];
+  if(length > _data_size){
+    length = _data_size; // (invalid)
+  }
+  return (length == 0) || _storage.read(address + UPLINK_LOG_HEADER_SIZE, data, length);
+}
+
+// --------------------------------------------------
+
+// Mark the oldest record pending as sent
+//  @returns true if a record was removed [bool]
+bool UplinkLog::pop(void){
+  if(_available == 0){
+    return false;
+  }
+  if(!_write_state(_tail, UPLINK_LOG_STATE_SENT)){
+    return false;
+  }
+  _tail = (_tail + 1) % _capacity;
+  _available--;
+  return true;
+}
+
+// --------------------------------------------------
+
+// Remove the oldest record pending without sending it
+//  @returns true if a record was removed [bool]
+//  NOTE: used for the records that can't be sent (see <rejected()>)
+bool UplinkLog::reject(void){
+  if(!pop()){
+    return false;
+  }
+  _rejected++;
+  return true;
+}
+
+// --------------------------------------------------
+
+// Get the number of records removed without being sent
+//  @returns the number of records [uint32_t]
+//  NOTE: not persistent
+uint32_t UplinkLog::rejected(void){
+  return _rejected;
+}
+
+// --------------------------------------------------
+// --------------------------------------------------
+
+// Get the address of a record
+//  @param (index) : the index of the record [uint16_t]
+//  @returns the address in the storage [uint32_t]
+uint32_t UplinkLog::_address(uint16_t index){
+  return static_cast<uint32_t>(index) * (UPLINK_LOG_HEADER_SIZE + _data_size);
+}
+
+// --------------------------------------------------
+
+// Write the state of a record
+//  @param (index) : the index of the record [uint16_t]
+//         (state) : the new state [uint8_t]
+//  @returns true if written [bool]
+bool UplinkLog::_write_state(uint16_t index, uint8_t state){
+  return _storage.write(_address(index) + UPLINK_LOG_OFFSET_STATE, &state, 1);
+}
+
+// --------------------------------------------------
@@ -0,0 +1,94 @@
+#ifndef UPLINK_LOG_H
+#define UPLINK_LOG_H
+
+/*******************************************************************************
+* RoboCore Uplink Log Library (v1.0)
+* 
+* Library to store the uplinks in a persistent ring (store-and-forward).
+* 
+* Copyright 2022 RoboCore.
+* 
+* 
+* This file is part of the SMW_SX1276M0 library ("SMW_SX1276M0-lib").
+* 
+* "SMW_SX1276M0-lib" is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+* 
+* "SMW_SX1276M0-lib" is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+* 
+* You should have received a copy of the GNU Lesser General Public License
+* along with "SMW_SX1276M0-lib". If not, see <https://www.gnu.org/licenses/>
+*******************************************************************************/
+
+// --------------------------------------------------
+// Dependencies
+
+extern "C" {
+  #include <stdint.h>
+}
+
+// --------------------------------------------------
+// Constants
+
+#define UPLINK_LOG_DATA_SIZE  27 // [bytes] (default and maximum, a record uses 5 more bytes)
+
+// The header of each record: [sequence (2)][state][port][length], followed by the data
+#define UPLINK_LOG_HEADER_SIZE 5
+
+// -----------------------------------------------------------------
+
+// Interface to the persistent memory of the log (EEPROM, flash, file, ...)
+//  NOTE: the addresses go from 0 to <size() - 1>
+class LogStorage {
+  public:
+    virtual ~LogStorage() {}
+    virtual bool read(uint32_t, uint8_t *, uint16_t) = 0;
+    virtual uint32_t size(void) = 0;
+    virtual bool write(uint32_t, const uint8_t *, uint16_t) = 0;
+};
+
+// -----------------------------------------------------------------
+
+// Append-only log of uplinks, in a ring of fixed size records
+//  NOTE: there is no fixed index in the memory: the position of the records is
+//        found by their sequence in <begin()>, so the writes are spread evenly
+//  NOTE: when full, the oldest record is overwritten (see <dropped()>)
+//  NOTE: the RAM used doesn't depend on the size of the storage
+class UplinkLog {
+  public:
+    UplinkLog(LogStorage &, uint8_t = UPLINK_LOG_DATA_SIZE);
+    bool append(uint8_t, const uint8_t *, uint8_t);
+    uint16_t available(void);
+    bool begin(void);
+    uint16_t capacity(void);
+    void clear(void);
+    uint8_t data_size(void);
+    uint32_t dropped(void);
+    bool peek(uint8_t &, uint8_t *, uint8_t &);
+    bool pop(void);
+    bool reject(void);
+    uint32_t rejected(void);
+
+  private:
+    LogStorage &_storage;
+    uint8_t _data_size; // the maximum length of the data of a record
+    uint16_t _capacity; // the number of records
+    uint16_t _head; // the next record to write
+    uint16_t _tail; // the oldest record pending
+    uint16_t _available; // the number of records pending
+    uint16_t _sequence; // the sequence of the next record
+    uint32_t _dropped; // the number of records overwritten before being sent
+    uint32_t _rejected; // the number of records removed without being sent
+
+    uint32_t _address(uint16_t);
+    bool _write_state(uint16_t, uint8_t);
+};
+
+// -----------------------------------------------------------------
+
+#endif // UPLINK_LOG_H